@@ -0,0 +1,39 @@
+#ifndef ANIMATION_CLIP_H
+#define ANIMATION_CLIP_H
+
+#include <SDL2/SDL.h>
+#include <cstddef>
+
+/**
+ * AnimationClip - An immutable run of sprite sheet frames
+ *
+ * Features:
+ * - Defined once, typically as constexpr tables, and shared by pointer:
+ *   any number of sprites can play the same clip
+ * - A Sprite playing a clip only keeps its frame index and timer, so
+ *   switching clips copies nothing and never allocates
+ *
+ * The frames must outlive every sprite playing the clip (static tables
+ * do).
+ *
+ * Usage:
+ * constexpr SDL_Rect RUN_FRAMES[] = {{0, 48, 32, 48}, {32, 48, 32, 48}};
+ * constexpr AnimationClip RUN = AnimationClip::of(RUN_FRAMES, 0.1f);
+ * sprite.setClip(&RUN);
+ */
+struct AnimationClip {
+  const SDL_Rect *frames;
+  size_t frameCount;
+  float frameDuration; // Seconds per frame
+  bool looping;
+
+  // Clip over a whole frame table
+  template <size_t N>
+  static constexpr AnimationClip of(const SDL_Rect (&frames)[N],
+                                    float frameDuration,
+                                    bool looping = true) {
+    return AnimationClip{frames, N, frameDuration, looping};
+  }
+};
+
+#endif // ANIMATION_CLIP_H
@@ -0,0 +1,83 @@
+#ifndef ASSET_LOADER_H
+#define ASSET_LOADER_H
+
+#include "job_system.h"
+#include <SDL2/SDL.h>
+#include <SDL2/SDL_mixer.h>
+#include <SDL2/SDL_ttf.h>
+#include <future>
+#include <memory>
+#include <string>
+#include <unordered_map>
+
+/**
+ * AssetLoader - Decodes images, sounds, music and fonts on worker threads
+ *
+ * Features:
+ * - Each load*() call queues the decode on the shared JobSystem and
+ *   returns immediately, so independent assets decode in parallel
+ * - take*() blocks until that asset is ready and hands over ownership;
+ *   wait() is a barrier for everything queued
+ * - Only CPU work runs on the workers. GPU uploads (textures) remain the
+ *   caller's job on the renderer thread.
+ *
+ * Decode failures are rethrown from take*() as std::runtime_error. Results
+ * that are never taken are freed when the loader is destroyed.
+ *
+ * Usage:
+ * AssetLoader assets(jobs);
+ * assets.loadImage("player.png");
+ * assets.loadSound("jump", "jump.wav");
+ * ... other startup work ...
+ * auto texture = textureCache.load("player.png", assets.takeImage("player.png"));
+ */
+class AssetLoader {
+public:
+  using SurfacePtr = std::unique_ptr<SDL_Surface, void (*)(SDL_Surface *)>;
+
+  // A sound is either decoded or, when long, opened as a stream (see
+  // AudioManager::openStreamedSound()); exactly one is set
+  struct Sound {
+    Mix_Chunk *chunk = nullptr;
+    Mix_Music *stream = nullptr;
+    explicit operator bool() const { return chunk || stream; }
+  };
+
+  explicit AssetLoader(std::shared_ptr<JobSystem> jobs);
+  ~AssetLoader();
+
+  // Queue decodes. Queuing the same key twice is a no-op.
+  void loadImage(const std::string &filePath);
+  void loadSound(const std::string &id, const std::string &filePath);
+  void loadMusic(const std::string &filePath);
+  void loadFont(const std::string &filePath, int pointSize);
+
+  /**
+   * Block until every queued decode has finished (successfully or not)
+   */
+  void wait();
+
+  /**
+   * Collect a decoded asset; blocks until it is ready
+   * @return Owned result (free with SDL_FreeSurface / Mix_FreeChunk /
+   *         Mix_FreeMusic / TTF_CloseFont, or hand to an owner)
+   * @throws std::runtime_error if it was never queued or failed to decode
+   */
+  SurfacePtr takeImage(const std::string &filePath);
+  Sound takeSound(const std::string &id);
+  Mix_Music *takeMusic(const std::string &filePath);
+  TTF_Font *takeFont(const std::string &filePath);
+
+  AssetLoader(const AssetLoader &) = delete;
+  AssetLoader &operator=(const AssetLoader &) = delete;
+
+private:
+  std::shared_ptr<JobSystem> jobs;
+
+  std::unordered_map<std::string, std::future<SDL_Surface *>> images;
+  std::unordered_map<std::string, std::future<Sound>> sounds;
+  std::unordered_map<std::string, std::future<Mix_Music *>> music;
+  std::unordered_map<std::string, std::future<TTF_Font *>> fonts;
+};
+
+#endif // ASSET_LOADER_H
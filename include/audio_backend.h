@@ -0,0 +1,233 @@
+#ifndef AUDIO_BACKEND_H
+#define AUDIO_BACKEND_H
+
+#include "sound_id.h"
+#include <SDL2/SDL.h>
+#include <SDL2/SDL_mixer.h>
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <unordered_map>
+#include <unordered_set>
+#include <vector>
+
+/**
+ * AudioBackend - Output device behind AudioManager
+ *
+ * AudioManager decides what plays, on which voice and how loud; a backend
+ * only carries it out. Implementations:
+ * - SdlMixerAudioBackend: real output through SDL_mixer
+ * - NullAudioBackend: accepts everything, outputs nothing, no device needed
+ * - RecordingAudioBackend: like null, but logs every sound started
+ *
+ * Voices are indices in [0, voice count). All calls come from the thread
+ * that runs AudioManager::update().
+ */
+class AudioBackend {
+public:
+  virtual ~AudioBackend() = default;
+
+  /**
+   * Open the output device
+   * @throws std::runtime_error on failure
+   */
+  virtual void open(int frequency, Uint16 format, int channels,
+                    int chunksize) = 0;
+  virtual void close() = 0;
+
+  // Number of voices that can play at once
+  virtual void setVoiceCount(int count) = 0;
+
+  // Whether loaders should decode sample data for this backend
+  virtual bool needsSampleData() const = 0;
+
+  // Sound data, keyed by handle. chunk may be null when
+  // needsSampleData() is false. Ownership of chunk is taken.
+  virtual bool addSound(SoundHandle sound, Mix_Chunk *chunk) = 0;
+  virtual bool hasSound(SoundHandle sound) const = 0;
+  virtual void setSoundVolume(int volume) = 0; // 0..MIX_MAX_VOLUME, all sounds
+
+  // Decoded sample bytes held for one sound / for all sounds (streams
+  // count as 0)
+  virtual size_t getSoundBytes(SoundHandle sound) const = 0;
+  virtual size_t getTotalSoundBytes() const = 0;
+
+  // Long sounds, kept undecoded and played through the music stream.
+  // Ownership of stream is taken; may be null when needsSampleData() is
+  // false.
+  virtual bool addStream(SoundHandle sound, Mix_Music *stream) = 0;
+  virtual bool hasStream(SoundHandle sound) const = 0;
+
+  /**
+   * Replace what the music stream plays with a streamed sound
+   * @param fadeMs Fade the current music out, then this one in, over fadeMs
+   *               each (0 switches at once)
+   */
+  virtual bool playStream(SoundHandle sound, int loops, int volume,
+                          int fadeMs) = 0;
+
+  // Background music. Ownership of music is taken; may be null when
+  // needsSampleData() is false. playMusic() fades like playStream().
+  virtual bool setMusic(Mix_Music *music) = 0;
+  virtual bool playMusic(int loops, int volume, int fadeMs) = 0;
+  virtual void haltMusic() = 0;
+  virtual void setMusicVolume(int volume) = 0; // 0..MIX_MAX_VOLUME
+
+  // Called once at the start of every AudioManager::update()
+  virtual void beginTick(std::uint64_t /*tick*/) {}
+
+  /**
+   * Start a sound on a voice (the voice is already stopped)
+   * @param positional Whether gains will change while it plays
+   * @param left, right Initial stereo gains (0..1)
+   */
+  virtual bool play(int voice, SoundHandle sound, int loops, bool positional,
+                    float left, float right) = 0;
+  virtual bool isPlaying(int voice) const = 0;
+  virtual void halt(int voice) = 0; // -1 stops every voice
+  virtual void setGains(int voice, float left, float right) = 0;
+};
+
+/**
+ * Real audio output through SDL_mixer. Voice i is mixer channel i; gains of
+ * positional voices are applied by a per-channel post-mix effect.
+ */
+class SdlMixerAudioBackend : public AudioBackend {
+public:
+  SdlMixerAudioBackend();
+  ~SdlMixerAudioBackend() override;
+
+  void open(int frequency, Uint16 format, int channels,
+            int chunksize) override;
+  void close() override;
+  void setVoiceCount(int count) override;
+  bool needsSampleData() const override { return true; }
+
+  bool addSound(SoundHandle sound, Mix_Chunk *chunk) override;
+  bool hasSound(SoundHandle sound) const override;
+  void setSoundVolume(int volume) override;
+  size_t getSoundBytes(SoundHandle sound) const override;
+  size_t getTotalSoundBytes() const override { return soundBytes; }
+
+  bool addStream(SoundHandle sound, Mix_Music *stream) override;
+  bool hasStream(SoundHandle sound) const override;
+  bool playStream(SoundHandle sound, int loops, int volume,
+                  int fadeMs) override;
+
+  bool setMusic(Mix_Music *music) override;
+  bool playMusic(int loops, int volume, int fadeMs) override;
+  void haltMusic() override;
+  void setMusicVolume(int volume) override;
+
+  void beginTick(std::uint64_t tick) override;
+  bool play(int voice, SoundHandle sound, int loops, bool positional,
+            float left, float right) override;
+  bool isPlaying(int voice) const override;
+  void halt(int voice) override;
+  void setGains(int voice, float left, float right) override;
+
+private:
+  using ChunkPtr = std::unique_ptr<Mix_Chunk, void (*)(Mix_Chunk *)>;
+  using MusicPtr = std::unique_ptr<Mix_Music, void (*)(Mix_Music *)>;
+
+  bool opened = false;
+  bool stereoS16 = false; // The effect needs 16-bit stereo; else volume only
+  int soundVolume = MIX_MAX_VOLUME;
+  int voiceCount = 0;
+
+  std::unordered_map<SoundHandle, ChunkPtr> sounds;
+  std::unordered_map<SoundHandle, MusicPtr> streams;
+  MusicPtr music;
+  size_t soundBytes = 0;
+
+  // SDL_mixer has a single music stream, so a transition fades the current
+  // track out and starts the next one from beginTick() once it is silent
+  struct PendingTrack {
+    Mix_Music *track = nullptr;
+    int loops = 0;
+    int volume = 0;
+    int fadeMs = 0;
+  };
+  PendingTrack pending;
+
+  bool startTrack(Mix_Music *track, int loops, int volume, int fadeMs);
+
+  // Per-channel gains read on the audio thread: Q15 left << 16 | right
+  std::unique_ptr<std::atomic<Uint32>[]> voiceGains;
+
+  static void positionEffect(int channel, void *stream, int length,
+                             void *userData);
+};
+
+/**
+ * Discards all output. Needs no device, so simulation can run headless and
+ * faster than real time. Voices finish instantly.
+ */
+class NullAudioBackend : public AudioBackend {
+public:
+  void open(int, Uint16, int, int) override {}
+  void close() override {}
+  void setVoiceCount(int) override {}
+  bool needsSampleData() const override { return false; }
+
+  bool addSound(SoundHandle sound, Mix_Chunk *chunk) override;
+  bool hasSound(SoundHandle sound) const override;
+  void setSoundVolume(int volume) override { soundVolume = volume; }
+  size_t getSoundBytes(SoundHandle) const override { return 0; }
+  size_t getTotalSoundBytes() const override { return 0; }
+
+  bool addStream(SoundHandle sound, Mix_Music *stream) override;
+  bool hasStream(SoundHandle sound) const override;
+  bool playStream(SoundHandle sound, int, int, int) override {
+    return hasStream(sound);
+  }
+
+  bool setMusic(Mix_Music *music) override;
+  bool playMusic(int, int, int) override { return true; }
+  void haltMusic() override {}
+  void setMusicVolume(int) override {}
+
+  bool play(int, SoundHandle sound, int, bool, float, float) override {
+    return hasSound(sound);
+  }
+  bool isPlaying(int) const override { return false; }
+  void halt(int) override {}
+  void setGains(int, float, float) override {}
+
+protected:
+  std::unordered_set<SoundHandle> sounds;
+  std::unordered_set<SoundHandle> streams;
+  int soundVolume = MIX_MAX_VOLUME;
+};
+
+/**
+ * Null output that keeps an in-memory log of every sound started (voices
+ * and streams), for tests and replays to assert on.
+ */
+class RecordingAudioBackend : public NullAudioBackend {
+public:
+  struct Event {
+    std::uint64_t tick; // AudioManager::update() count
+    SoundHandle sound;
+    float volume; // Effective 0..1: sound volume times the louder ear
+    float left;   // Stereo gains (0..1)
+    float right;
+    int loops;
+  };
+
+  void beginTick(std::uint64_t tick) override { currentTick = tick; }
+  bool play(int voice, SoundHandle sound, int loops, bool positional,
+            float left, float right) override;
+  bool playStream(SoundHandle sound, int loops, int volume,
+                  int fadeMs) override;
+
+  const std::vector<Event> &getEvents() const { return events; }
+  void clearEvents() { events.clear(); }
+
+private:
+  std::uint64_t currentTick = 0;
+  std::vector<Event> events;
+};
+
+#endif // AUDIO_BACKEND_H
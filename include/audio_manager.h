@@ -1,19 +1,39 @@
 #ifndef AUDIO_MANAGER_H
 #define AUDIO_MANAGER_H
 
+#include "audio_backend.h"
 #include "config.h"
+#include "sound_id.h"
+#include "spsc_queue.h"
+#include "voice_manager.h"
 #include <SDL2/SDL.h>
 #include <SDL2/SDL_mixer.h>
+#include <cstdint>
 #include <memory>
 #include <string>
 #include <unordered_map>
+#include <vector>
 
 /**
  * AudioManager - Centralized audio resource management for SDL_mixer
  *
  * Features:
- * - RAII wrappers for Mix_Chunk and Mix_Music with automatic cleanup
- * - Sound effect loading and playing by string ID
+ * - Output goes through an AudioBackend: SDL_mixer by default, or a null /
+ *   recording backend for headless runs and tests
+ * - Sound effects registered by name and played by integer SoundHandle
+ * - playSound() only enqueues on a lock-free ring buffer; update() plays
+ *   the queued sounds once per frame
+ * - A fixed voice budget (see VoiceManager): duplicate requests for a sound
+ *   within one update() are merged, and per-sound priority/instance caps
+ *   decide what plays when voices run out
+ * - Positional sounds: distance attenuation and stereo panning relative to
+ *   a listener, computed in one pass per update(); out-of-range voices are
+ *   culled
+ * - Long sounds (decoded size >= AUDIO_STREAM_THRESHOLD_BYTES) stay
+ *   undecoded and play through the music stream, with a fade between them
+ *   and the background music
+ * - Decoded bytes are tracked per sound and capped by
+ *   AUDIO_MEMORY_BUDGET_BYTES
  * - Channel management and volume control
  * - Exception-safe initialization and cleanup
  *
@@ -21,12 +41,13 @@
  * AudioManager audio;
  * audio.init();
  * audio.loadSound("jump", "sounds/jump.wav");
- * audio.playSound("jump", 1.0f);
+ * audio.playSound(hashSoundName("jump"));
+ * audio.update(); // once per frame
  */
 class AudioManager {
 public:
   /**
-   * Initialize SDL_mixer audio subsystem
+   * Open the backend's output device
    * @param frequency Sample rate (default: 44100)
    * @param format Audio format (default: MIX_DEFAULT_FORMAT)
    * @param channels Audio channels (default: 2 for stereo)
@@ -37,7 +58,8 @@ public:
             int channels = 2, int chunksize = 512);
 
   /**
-   * Load a sound effect from file and register it with an ID
+   * Load a sound effect from file and register it with an ID. Long sounds
+   * are registered as streams (see openStreamedSound()).
    * @param id String identifier for the sound
    * @param filePath Path to audio file (WAV, OGG, etc.)
    * @return true if loaded successfully, false otherwise
@@ -52,20 +74,93 @@ public:
   bool loadMusic(const char *filePath);
 
   /**
-   * Play a sound effect by ID
-   * @param id Sound identifier previously loaded
-   * @param volume Volume multiplier (0.0 to 1.0)
+   * Register a sound effect decoded elsewhere (e.g. by AssetLoader)
+   * @param id String identifier for the sound
+   * @param chunk Decoded chunk; ownership is taken
+   * @return true if stored, false if chunk is null or audio is not ready
+   */
+  bool addSound(const std::string &id, Mix_Chunk *chunk);
+
+  /**
+   * Register a long sound that plays through the music stream. Playing it
+   * fades out the background music (and back in with playMusic()).
+   * @param id String identifier for the sound
+   * @param stream Opened music; ownership is taken
+   * @return true if stored, false if stream is null or audio is not ready
+   */
+  bool addStreamedSound(const std::string &id, Mix_Music *stream);
+
+  /**
+   * Classify a sound file by its decoded size. Thread-safe.
+   * @return The file opened as a stream if decoding it would take at least
+   *         AUDIO_STREAM_THRESHOLD_BYTES, else nullptr (decode it with
+   *         Mix_LoadWAV)
+   */
+  static Mix_Music *openStreamedSound(const char *filePath);
+
+  /**
+   * Use music decoded elsewhere as the background music
+   * @param mus Decoded music; ownership is taken
+   * @return true if stored, false if mus is null or audio is not ready
+   */
+  bool setMusic(Mix_Music *mus);
+
+  /**
+   * Request a sound effect. Never allocates or blocks; the sound starts on
+   * the next update(). Requests must come from a single producer thread.
+   * @param sound Handle of a registered sound (a SoundId converts)
    * @param loops Number of extra loops (-1 for infinite, 0 for play once)
-   * @return Channel number used, or -1 on error
+   * @return false if the command queue is full and the request was dropped
+   */
+  bool playSound(SoundHandle sound, int loops = 0);
+
+  /**
+   * Request a sound emitted at a world position. It is attenuated and
+   * panned relative to the listener, and culled while out of range.
+   * @param worldX, worldY Emitter position in world pixels
+   */
+  bool playSoundAt(SoundHandle sound, float worldX, float worldY,
+                   int loops = 0);
+
+  /**
+   * Set where positional sounds are heard from (usually the player)
+   */
+  void setListener(float worldX, float worldY);
+
+  /**
+   * Play every queued sound request. Call once per frame (or from a
+   * dedicated audio thread - the single consumer).
    */
-  int playSound(const std::string &id, int loops = 0);
+  void update();
+
+  /**
+   * Set how a sound competes for voices
+   * @param sound Sound handle
+   * @param priority Higher priorities steal voices from lower ones
+   * @param maxInstances Simultaneous instances before the oldest restarts
+   */
+  void setSoundParams(SoundHandle sound, int priority,
+                      int maxInstances = AUDIO_DEFAULT_MAX_INSTANCES);
+
+  // Requests dropped because no voice could be claimed
+  size_t getDroppedSoundCount() const { return droppedSounds; }
+
+  // Positional sounds skipped or stopped for being out of range
+  size_t getCulledSoundCount() const { return culledSounds; }
+
+  // Decoded sample data held in memory, for one sound and for all of them
+  size_t getSoundBytes(SoundHandle sound) const {
+    return backend->getSoundBytes(sound);
+  }
+  size_t getTotalSoundBytes() const { return backend->getTotalSoundBytes(); }
 
   /**
    * Play background music
    * @param loops Number of loops (-1 for infinite, 0 for play once)
+   * @param fadeMs Fade out a playing streamed sound, then the music in
    * @return true if music started successfully
    */
-  bool playMusic(int loops = -1);
+  bool playMusic(int loops = -1, int fadeMs = 0);
 
   /**
    * Stop all playing sounds and music
@@ -99,8 +194,16 @@ public:
    */
   bool isInitialized() const { return initialized; }
 
+  // Whether sounds/music need decoded sample data (false for null outputs)
+  bool needsSampleData() const { return backend->needsSampleData(); }
+
+  AudioBackend &getBackend() { return *backend; }
+
   // Rule of 5: proper resource management
-  AudioManager();
+  /**
+   * @param backend Output to use; nullptr selects SDL_mixer
+   */
+  explicit AudioManager(std::unique_ptr<AudioBackend> backend = nullptr);
   ~AudioManager();
   AudioManager(const AudioManager &) = delete;
   AudioManager &operator=(const AudioManager &) = delete;
@@ -110,42 +213,70 @@ public:
 private:
   bool initialized = false;
 
-  // Smart pointer type for Mix_Chunk with custom deleter
-  using ChunkPtr = std::unique_ptr<Mix_Chunk, void (*)(Mix_Chunk *)>;
+  // Output device; SDL_mixer unless another backend was given
+  std::unique_ptr<AudioBackend> backend;
+
+  // Name registered under each handle. Handles are name hashes, so two
+  // names could collide; the second one is rejected.
+  std::unordered_map<SoundHandle, std::string> soundNames;
 
-  // Smart pointer type for Mix_Music with custom deleter
-  using MusicPtr = std::unique_ptr<Mix_Music, void (*)(Mix_Music *)>;
+  /**
+   * Handle for a sound name being registered
+   * @return false if another name already holds the handle
+   */
+  bool claimHandle(const std::string &id, SoundHandle &handle);
 
-  // Sound effects storage
-  std::unordered_map<std::string, ChunkPtr> sounds;
+  // Pending playSound() requests
+  struct PlayCommand {
+    SoundHandle sound;
+    int loops;
+    bool positional;
+    float x; // World position when positional
+    float y;
+  };
+  SpscQueue<PlayCommand, AUDIO_COMMAND_QUEUE_SIZE> commands;
+  std::uint64_t tick = 0; // update() count
 
-  // Background music
-  MusicPtr music;
+  // Voice allocation; voice index == backend voice (mixer channel)
+  VoiceManager voices;
+  size_t droppedSounds = 0;
 
-  // Volume settings
-  int soundVolume = SOUND_EFFECT_VOLUME;
-  int musicVolume = MUSIC_VOLUME;
+  // Free voices that finished on their own
+  void reclaimVoices();
 
-  /**
-   * Helper to create ChunkPtr with proper deleter
-   */
-  static ChunkPtr makeChunkPtr(Mix_Chunk *chunk);
+  // Positional audio. Gains for every voice are computed in one pass per
+  // update() and handed to the backend.
+  struct VoiceEmitter {
+    bool positional = false;
+    float x = 0.0f;
+    float y = 0.0f;
+  };
+  std::vector<VoiceEmitter> emitters; // Indexed by voice
+  float listenerX = 0.0f;
+  float listenerY = 0.0f;
+  size_t culledSounds = 0;
 
   /**
-   * Helper to create MusicPtr with proper deleter
+   * Gains for an emitter relative to the listener
+   * @return false if the emitter is out of audible range
    */
-  static MusicPtr makeMusicPtr(Mix_Music *music);
+  bool computeGains(float x, float y, float &left, float &right) const;
+  void updateVoiceGains();
+
+  // Volume settings
+  int soundVolume = SOUND_EFFECT_VOLUME;
+  int musicVolume = MUSIC_VOLUME;
 };
 
 // Player sound effect IDs - use these constants for consistency
 namespace PlayerSounds {
-constexpr const char *DEATH = "player_death";
-constexpr const char *DASH = "player_dash";
-constexpr const char *COLLECT_COIN = "player_collect_coin";
-constexpr const char *HIT_BY_ARROW = "player_hit_by_arrow";
-constexpr const char *DEAD_BY_TRAP = "player_dead_by_trap";
-constexpr const char *JUMP = "player_jump";
-constexpr const char *WIN = "player_win";
+constexpr SoundId DEATH = "player_death";
+constexpr SoundId DASH = "player_dash";
+constexpr SoundId COLLECT_COIN = "player_collect_coin";
+constexpr SoundId HIT_BY_ARROW = "player_hit_by_arrow";
+constexpr SoundId DEAD_BY_TRAP = "player_dead_by_trap";
+constexpr SoundId JUMP = "player_jump";
+constexpr SoundId WIN = "player_win";
 } // namespace PlayerSounds
 
 #endif // AUDIO_MANAGER_H
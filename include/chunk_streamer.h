@@ -0,0 +1,154 @@
+#ifndef CHUNK_STREAMER_H
+#define CHUNK_STREAMER_H
+
+#include "components.h"
+#include "config.h"
+#include "disappearing_platform.h"
+#include "platform.h"
+#include <SDL2/SDL.h>
+#include <condition_variable>
+#include <cstddef>
+#include <deque>
+#include <functional>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <thread>
+#include <unordered_map>
+#include <unordered_set>
+#include <vector>
+
+/**
+ * Identifies one chunk of one layer (chunk coordinates, not tiles)
+ */
+struct ChunkId {
+  int layer;
+  int x;
+  int y;
+
+  bool operator==(const ChunkId &other) const {
+    return layer == other.layer && x == other.x && y == other.y;
+  }
+};
+
+struct ChunkIdHash {
+  size_t operator()(const ChunkId &id) const {
+    size_t h = std::hash<int>()(id.layer);
+    h = h * 31 + std::hash<int>()(id.x);
+    h = h * 31 + std::hash<int>()(id.y);
+    return h;
+  }
+};
+
+/**
+ * Where a chunk's data lives in the TMX file
+ */
+struct ChunkRequest {
+  ChunkId id;
+  int tileX; // Top-left tile of the chunk
+  int tileY;
+  int width; // Size in tiles
+  int height;
+  size_t dataOffset; // Byte offset of the CSV text
+};
+
+/**
+ * Everything built for one chunk on the streaming thread
+ */
+struct ChunkLoad {
+  ChunkId id;
+  std::vector<std::shared_ptr<Platform>> tiles; // Row-major, chunk sized
+  std::vector<EntitySpawn> spawns; // Coins and arrows
+  std::vector<std::shared_ptr<DisappearingPlatform>> disappearingPlatforms;
+  size_t bytes = 0; // Estimated resident memory
+};
+
+/**
+ * ChunkStreamer - Loads infinite-map chunks around a focus point
+ *
+ * Responsibilities:
+ * - Keeps the index of every chunk in the map (from TMXParser)
+ * - Decodes and builds chunks on a background thread, reading only the
+ *   chunk's bytes from the TMX file
+ * - Decides residency: everything within the prefetch radius of the focus
+ *   is requested; chunks outside it stay cached until the memory budget is
+ *   exceeded, then the farthest are evicted first
+ *
+ * The streamer never touches the world itself: update() hands the owner
+ * the chunks to install and the chunk ids to remove.
+ */
+class ChunkStreamer {
+public:
+  // Builds game objects for a chunk from its GIDs (runs on the worker)
+  using Builder = std::function<void(const ChunkRequest &,
+                                     const std::vector<int> &, ChunkLoad &)>;
+
+  struct Update {
+    std::vector<ChunkLoad> loaded;
+    std::vector<ChunkId> evicted;
+  };
+
+  /**
+   * @param tmxFilePath File the chunk offsets refer to
+   * @param chunkWidth, chunkHeight Chunk size in tiles (uniform per map)
+   * @param builder Chunk builder; must be safe to call from another thread
+   * @param prefetchRadius Chunks around the focus chunk kept resident
+   * @param memoryBudget Bytes of chunk data allowed before evicting
+   */
+  ChunkStreamer(const std::string &tmxFilePath, int chunkWidth,
+                int chunkHeight, Builder builder,
+                int prefetchRadius = CHUNK_PREFETCH_RADIUS,
+                size_t memoryBudget = CHUNK_MEMORY_BUDGET_BYTES);
+  ~ChunkStreamer();
+
+  // Register a chunk from the TMX index
+  void addChunk(const ChunkRequest &request);
+
+  /**
+   * Request/evict chunks for the current focus and collect finished loads
+   * @param focusTileX, focusTileY Focus position in tiles
+   */
+  Update update(int focusTileX, int focusTileY);
+
+  // Drop a resident chunk so the next update() streams it in again. The
+  // owner is expected to have uninstalled it already.
+  void invalidate(const ChunkId &id);
+
+  int getChunkWidth() const { return chunkWidth; }
+  int getChunkHeight() const { return chunkHeight; }
+  size_t getResidentBytes() const { return residentBytes; }
+  size_t getResidentCount() const { return resident.size(); }
+
+  ChunkStreamer(const ChunkStreamer &) = delete;
+  ChunkStreamer &operator=(const ChunkStreamer &) = delete;
+  ChunkStreamer(ChunkStreamer &&) = delete;
+  ChunkStreamer &operator=(ChunkStreamer &&) = delete;
+
+private:
+  std::string tmxFilePath;
+  int chunkWidth;
+  int chunkHeight;
+  Builder builder;
+  int prefetchRadius;
+  size_t memoryBudget;
+
+  // Owner-thread state
+  std::unordered_map<ChunkId, ChunkRequest, ChunkIdHash> index;
+  std::unordered_map<ChunkId, size_t, ChunkIdHash> resident; // id -> bytes
+  std::unordered_set<ChunkId, ChunkIdHash> pending;
+  size_t residentBytes = 0;
+  int maxLayer = -1;
+
+  // Shared with the worker
+  std::mutex mutex;
+  std::condition_variable wake;
+  std::deque<ChunkRequest> requests;
+  std::vector<ChunkLoad> completed;
+  bool stopping = false;
+  std::thread worker;
+
+  void workerLoop();
+  int distance(const ChunkId &id, int focusX, int focusY) const;
+};
+
+#endif // CHUNK_STREAMER_H
@@ -9,9 +9,8 @@
  * Object types for collision handling
  */
 enum class ObjectType {
-  PLAYER,        // Dynamic player character
-  STATIC_OBJECT, // Platforms, spikes, lava, walls
-  PROJECTILE     // Arrows, bullets, coins, collectibles
+  PLAYER,       // Dynamic player character
+  STATIC_OBJECT // Platforms, spikes, lava, walls
 };
 
 /**
@@ -9,8 +9,9 @@
  *
  * Handles collision detection and response between:
  * - Player vs Static Objects (platforms, traps)
- * - Player vs Projectiles (collectibles, arrows)
- * - Projectiles vs Static Objects (bouncing, sticking)
+ *
+ * Coins and arrows are registry entities; EntitySystems::touchPlayer tests
+ * them with the helpers below.
  */
 class CollisionSystem {
 public:
@@ -52,10 +53,6 @@ public:
 private:
   // Specific collision handlers
   static void handlePlayerVsStatic(Collideable *player, Collideable *staticObj);
-  static void handlePlayerVsProjectile(Collideable *player,
-                                       Collideable *projectile);
-  static void handleProjectileVsStatic(Collideable *projectile,
-                                       Collideable *staticObj);
 };
 
 #endif // COLLISION_SYSTEM_H
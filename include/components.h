@@ -0,0 +1,78 @@
+#ifndef COMPONENTS_H
+#define COMPONENTS_H
+
+#include "texture.h"
+#include <SDL2/SDL.h>
+
+/**
+ * Component - Plain data attached to registry entities (coins, arrows)
+ *
+ * Components hold no behavior and no owning pointers; EntitySystems act on
+ * them. Each is stored densely in its own ComponentPool, so a system only
+ * touches the arrays it needs.
+ *
+ * The mutable ones (Transform, Velocity, Timer) are made of 4-byte fields
+ * only: no padding, so their arrays can be saved for rewinding as raw
+ * bytes.
+ */
+namespace Component {
+
+// World-space box in pixels
+struct Transform {
+  float x, y;
+  float w, h;
+};
+
+// Pixels per second
+struct Velocity {
+  float x, y;
+};
+
+// Box the player is tested against, relative to the transform
+struct Collider {
+  float offsetX, offsetY;
+  float w, h;
+};
+
+// What is drawn at the transform. The texture is owned by the map.
+struct Sprite {
+  Texture *texture;
+  SDL_Rect src;
+  float offsetY; // Visual only (coin bobbing)
+};
+
+// Seconds since (re)spawn
+struct Timer {
+  float time;
+};
+
+// Collected on touch; counts towards the win condition
+struct Pickup {
+  float bobAmplitude; // Pixels
+  float bobFrequency; // Bobs per second
+};
+
+// Kills the player on touch; goes back to its spawn point when it leaves
+// the world
+struct Hazard {
+  float spawnX, spawnY;
+};
+
+} // namespace Component
+
+/**
+ * Everything needed to create one map entity. Built by the layer and chunk
+ * builders (possibly on worker threads) and spawned into the registry on
+ * the owner thread.
+ */
+struct EntitySpawn {
+  enum class Kind { COIN, ARROW };
+
+  Kind kind;
+  SDL_FRect bounds;
+  Texture *texture; // Map-owned tileset texture; may be null
+  SDL_Rect src;
+  float velocityX, velocityY;
+};
+
+#endif // COMPONENTS_H
@@ -9,6 +9,13 @@
 #define WINDOW_TITLE "RageBait"
 #define TARGET_WIDTH 800
 #define TARGET_HEIGHT 600
+#define IDLE_WAIT_TIMEOUT_MS 100 // Idle loop wake-ups (keeps audio serviced)
+
+// === FRAME PACING ===
+#define FRAME_CAP_DEFAULT_FPS 60  // Frame rate of the capped pacing mode
+#define FRAME_SPIN_THRESHOLD_MS 2 // Spin instead of sleeping this close
+#define FRAME_MISSED_TOLERANCE 1.5 // VSync frames longer than this many
+                                   // refresh periods count as missed
 
 // === PLAYER SETTINGS ===
 #define PLAYER_SPEED 120.0f
@@ -65,7 +72,7 @@
 // === MAP SETTINGS ===
 #define DEFAULT_MAP_WIDTH 90
 #define DEFAULT_MAP_HEIGHT 15
-#define MAP_FILE_PATH "../resources/map.tmx"
+#define MAP_FILE_PATH "map.tmx"
 #define BACK_GROUND "bg"
 #define COINS_LAYER_NAME "coin"
 #define SLOW_LAYER_NAME "slow"
@@ -73,9 +80,17 @@
 #define TRAPS_LAYER_NAME "trap"
 #define ARROW_LAYER_NAME "arrow"
 
+// === WORLD STREAMING (infinite maps) ===
+#define CHUNK_PREFETCH_RADIUS 1 // Chunks kept loaded around the player
+#define CHUNK_MEMORY_BUDGET_BYTES (32 * 1024 * 1024) // Cached chunk memory
+
 // === RESOURCE PATHS ===
-#define PLAYER_TEXTURE_PATH "../resources/monkey.png"
-#define FONT_PATH "../resources/PressStart2P-Regular.ttf"
+// Asset paths are relative to the resource root (see Vfs): the pack file
+// next to the executable, else the loose resources directory
+#define RESOURCE_PACK_NAME "resources.pak"
+#define RESOURCE_DIR_NAME "resources"
+#define PLAYER_TEXTURE_PATH "monkey.png"
+#define FONT_PATH "PressStart2P-Regular.ttf"
 
 // === SPECIAL TILE BEHAVIOR ===
 #define SLOW_SPEED_MULTIPLIER 0.5f
@@ -104,18 +119,27 @@
 #define KEY_DASH SDL_SCANCODE_LSHIFT
 #define KEY_DASH_ALT SDL_SCANCODE_RSHIFT
 #define KEY_PAUSE SDL_SCANCODE_ESCAPE
+#define KEY_CYCLE_PACING SDL_SCANCODE_F3 // VSync -> capped -> uncapped
+#define KEY_REWIND SDL_SCANCODE_R // Hold to step the world backwards
 
 // === GAME SETTINGS ===
 #define MAX_PLAYER_HEALTH 3
 #define PERFORMANCE_FREQUENCY_DIVISOR 1000.0
 #define ALPHA_OPAQUE 255
 #define GROUND_CHECK_HEIGHT 2.0f
+#define SIMULATION_TICK_RATE 120 // Fixed simulation steps per second
+#define SIMULATION_MAX_CATCHUP_TICKS 5 // Ticks replayed after a stall
+#define ENTITY_UPDATE_BATCH_SIZE 256 // Entities per parallel update job
+#define REWIND_SECONDS 5 // History kept for rewinding
+#define REWIND_KEYFRAME_INTERVAL 60 // Ticks per full snapshot
+#define REWIND_TICKS_PER_TICK 2 // Rewind speed while held
 
 // === RENDERING SETTINGS ===
 #define RENDER_SCALE_QUALITY "0" // Nearest neighbor for pixel art
 
 // === PHYSICS SETTINGS ===
 #define COLLISION_BOUNDS_PADDING 0.0f
+#define TILE_SWEEP_EPSILON 0.001f // Edges on a tile border don't enter it
 
 // === PROJECTILE PHYSICS ===
 #define PROJECTILE_GRAVITY 300.0f
@@ -124,17 +148,33 @@
 #define BULLET_VEL_X 10.0f
 #define BULLET_VEL_Y 10.0f
 #define COINS_BOUNCING_DEFAULT true
+#define COIN_BOB_AMPLITUDE 16.0f // Pixels; visual only
+#define COIN_BOB_FREQUENCY 2.0f  // Bobs per second
+
+// === PARTICLES ===
+#define PARTICLE_TEXTURE_SIZE 4 // White square every particle is tinted from
+#define PARTICLE_POOL_CAPACITY 512 // Live particles per effect
 
 // === AUDIO SETTINGS ===
 #define SOUND_EFFECT_VOLUME 128 // Max 128
 #define MUSIC_VOLUME 128
+#define AUDIO_COMMAND_QUEUE_SIZE 64 // Pending sound requests, power of two
+#define AUDIO_VOICE_COUNT 16          // Mixer channels sound effects share
+#define AUDIO_DEFAULT_MAX_INSTANCES 4 // Simultaneous instances per sound
+#define AUDIO_FULL_VOLUME_DISTANCE 96.0f // Positional sounds: px, no falloff
+#define AUDIO_MAX_DISTANCE 480.0f        // Silent (culled) beyond this
+#define AUDIO_PAN_DISTANCE 320.0f        // Horizontal offset for full pan
+#define AUDIO_STREAM_THRESHOLD_BYTES (1024 * 1024) // Longer sounds stream
+#define AUDIO_COMPRESSED_RATIO 10 // Decoded/file size guess for MP3, OGG...
+#define AUDIO_MEMORY_BUDGET_BYTES (16 * 1024 * 1024) // Decoded sound data
+#define AUDIO_CROSSFADE_MS 750 // Music <-> streamed sound transitions
 #define PLAY_MUSIC_DEFAULT true
-#define PATH_TO_MUSIC "../resources/music.mp3"
-#define PATH_TO_DEAD_BY_TRAP_SOUND "../resources/dead_by_trap.wav"
-#define PATH_TO_HIT_BY_ARROW_SOUND "../resources/hit_by_arrow.wav"
-#define PATH_TO_COLLECT_COIN_SOUND "../resources/collect_coin.wav"
-#define PATH_TO_DASH_SOUND "../resources/dash.wav"
-#define PATH_TO_JUMP_SOUND "../resources/jump.wav"
-#define PATH_TO_WIN_SOUND "../resources/win_music.mp3"
+#define PATH_TO_MUSIC "music.mp3"
+#define PATH_TO_DEAD_BY_TRAP_SOUND "dead_by_trap.wav"
+#define PATH_TO_HIT_BY_ARROW_SOUND "hit_by_arrow.wav"
+#define PATH_TO_COLLECT_COIN_SOUND "collect_coin.wav"
+#define PATH_TO_DASH_SOUND "dash.wav"
+#define PATH_TO_JUMP_SOUND "jump.wav"
+#define PATH_TO_WIN_SOUND "win_music.mp3"
 
 #endif // CONFIG_H
\ No newline at end of file
@@ -3,6 +3,7 @@
 
 #include "config.h"
 #include "platform.h"
+#include "state_stream.h"
 #include <chrono>
 
 /**
@@ -33,6 +34,10 @@ public:
   bool canCollide() const { return state == State::VISIBLE; }
   State getState() const { return state; }
 
+  // Rewind: the state machine and its timer
+  void saveState(StateWriter &out) const;
+  void loadState(StateReader &in);
+
 private:
   State state = State::VISIBLE;
   bool triggered = false;
@@ -0,0 +1,153 @@
+#ifndef ENTITY_REGISTRY_H
+#define ENTITY_REGISTRY_H
+
+#include "components.h"
+#include "state_stream.h"
+#include <SDL2/SDL.h>
+#include <vector>
+
+// Entity id: an index into the registry's per-entity tables. Ids of
+// destroyed entities are reused.
+using Entity = Uint32;
+
+/**
+ * ComponentPool - Dense storage for one component type (sparse set)
+ *
+ * Features:
+ * - Components sit contiguously in insertion order, next to the entity
+ *   that owns each one, so systems walk them as a plain array
+ * - O(1) add, find and remove; removal moves the last component into the
+ *   hole, so the array never has gaps
+ *
+ * Dense indices change when components are removed; hold entities, not
+ * indices, across removals.
+ *
+ * Usage:
+ * pool.add(entity, Component::Velocity{ARROW_SPEED, 0.0f});
+ * for (size_t i = 0; i < pool.size(); ++i) move(pool.entityAt(i), pool[i]);
+ */
+template <typename T> class ComponentPool {
+public:
+  // Add or replace the entity's component
+  T &add(Entity entity, const T &component) {
+    if (entity >= sparse.size())
+      sparse.resize(static_cast<size_t>(entity) + 1, NONE);
+    if (sparse[entity] != NONE)
+      return dense[sparse[entity]] = component;
+
+    sparse[entity] = static_cast<Uint32>(dense.size());
+    dense.push_back(component);
+    owners.push_back(entity);
+    return dense.back();
+  }
+
+  void remove(Entity entity) {
+    if (!has(entity))
+      return;
+    const Uint32 index = sparse[entity];
+    const Entity last = owners.back();
+    dense[index] = dense.back();
+    owners[index] = last;
+    sparse[last] = index;
+    dense.pop_back();
+    owners.pop_back();
+    sparse[entity] = NONE;
+  }
+
+  bool has(Entity entity) const {
+    return entity < sparse.size() && sparse[entity] != NONE;
+  }
+
+  // Component of the entity, or nullptr
+  T *find(Entity entity) {
+    return has(entity) ? &dense[sparse[entity]] : nullptr;
+  }
+  const T *find(Entity entity) const {
+    return has(entity) ? &dense[sparse[entity]] : nullptr;
+  }
+
+  // Component of an entity known to have one
+  T &get(Entity entity) { return dense[sparse[entity]]; }
+  const T &get(Entity entity) const { return dense[sparse[entity]]; }
+
+  // Dense access, for systems
+  size_t size() const { return dense.size(); }
+  T &operator[](size_t index) { return dense[index]; }
+  const T &operator[](size_t index) const { return dense[index]; }
+  Entity entityAt(size_t index) const { return owners[index]; }
+  T *data() { return dense.data(); }
+  const T *data() const { return dense.data(); }
+
+  void clear() {
+    dense.clear();
+    owners.clear();
+    sparse.clear();
+  }
+
+private:
+  static constexpr Uint32 NONE = 0xFFFFFFFFu;
+
+  std::vector<T> dense;
+  std::vector<Entity> owners; // Entity of each dense component
+  std::vector<Uint32> sparse; // Entity -> dense index, or NONE
+};
+
+/**
+ * EntityRegistry - The map's dynamic entities and their components
+ *
+ * Features:
+ * - One ComponentPool per component type; an entity is just the id the
+ *   pools are indexed by
+ * - Entities can be disabled instead of destroyed (collected coins): they
+ *   keep their components and slots, systems skip them, and enabling them
+ *   again costs nothing
+ * - saveState() copies the mutable pools as raw arrays, for rewinding.
+ *   Entities must not be created or destroyed between saving and loading.
+ *
+ * Not thread-safe; systems may split the dense arrays between workers as
+ * long as each worker only writes its own range.
+ *
+ * Usage:
+ * Entity coin = registry.create();
+ * registry.transforms.add(coin, {x, y, w, h});
+ * registry.setActive(coin, false); // collected
+ */
+class EntityRegistry {
+public:
+  ComponentPool<Component::Transform> transforms;
+  ComponentPool<Component::Velocity> velocities;
+  ComponentPool<Component::Collider> colliders;
+  ComponentPool<Component::Sprite> sprites;
+  ComponentPool<Component::Timer> timers;
+  ComponentPool<Component::Pickup> pickups;
+  ComponentPool<Component::Hazard> hazards;
+
+  // New active entity without components
+  Entity create();
+
+  // Remove the entity and all its components
+  void destroy(Entity entity);
+
+  // Destroy every entity
+  void clear();
+
+  bool isActive(Entity entity) const {
+    return entity < states.size() && states[entity] == ACTIVE;
+  }
+  void setActive(Entity entity, bool active);
+
+  // Live entities, active or not
+  size_t size() const { return states.size() - freeIds.size(); }
+
+  // Rewind: activity plus the transform, velocity and timer arrays
+  void saveState(StateWriter &out) const;
+  void loadState(StateReader &in);
+
+private:
+  enum State : Uint8 { FREE, ACTIVE, DISABLED };
+
+  std::vector<Uint8> states; // Per entity id
+  std::vector<Entity> freeIds;
+};
+
+#endif // ENTITY_REGISTRY_H
@@ -0,0 +1,60 @@
+#ifndef ENTITY_SYSTEMS_H
+#define ENTITY_SYSTEMS_H
+
+#include "entity_registry.h"
+#include "job_system.h"
+#include "render_snapshot.h"
+#include <SDL2/SDL.h>
+#include <vector>
+
+/**
+ * EntitySystems - Gameplay of the registry entities, one pass per system
+ *
+ * Each system walks the dense array of one component and looks up the few
+ * others it needs, skipping disabled entities. Per-entity systems split
+ * their array across the job system when one is given (nullptr runs them
+ * serially); effects that cross entities (the player, coin counts, sounds)
+ * are left to the caller.
+ *
+ * Usage:
+ * EntitySystems::move(registry, dt, worldBounds, jobs);
+ * EntitySystems::animate(registry, dt, jobs);
+ * EntitySystems::touchPlayer(registry, playerBounds, contacts, jobs);
+ */
+class EntitySystems {
+public:
+  // Overlap of the player with one collider
+  struct Contact {
+    bool hit;
+    float normalX, normalY, penetration; // From the player's side
+  };
+
+  /**
+   * Apply velocities. Hazards that leave the world go back to their spawn
+   * point; anything else that leaves it is disabled.
+   */
+  static void move(EntityRegistry &registry, float dt,
+                   const SDL_FRect &worldBounds, JobSystem *jobs);
+
+  // Advance timers and bob pickups around their (fixed) collider
+  static void animate(EntityRegistry &registry, float dt, JobSystem *jobs);
+
+  /**
+   * Test every active collider against the player
+   * @param contacts Resized to the collider count; contacts[i] belongs to
+   *        registry.colliders.entityAt(i)
+   */
+  static void touchPlayer(const EntityRegistry &registry,
+                          const SDL_FRect &playerBounds,
+                          std::vector<Contact> &contacts, JobSystem *jobs);
+
+  // Record every active sprite
+  static void render(const EntityRegistry &registry,
+                     RenderSnapshot &snapshot);
+
+  // Collision box of an entity with a transform and a collider
+  static SDL_FRect colliderBounds(const EntityRegistry &registry,
+                                  Entity entity);
+};
+
+#endif // ENTITY_SYSTEMS_H
@@ -0,0 +1,105 @@
+#ifndef FRAME_LIMITER_H
+#define FRAME_LIMITER_H
+
+#include "config.h"
+#include <SDL2/SDL.h>
+#include <functional>
+#include <string>
+
+// How the main loop paces its frames
+enum class PacingMode {
+  VSYNC,    // Present blocks until the display refreshes
+  UNCAPPED, // As fast as possible
+  CAPPED    // Fixed frame rate, timed by FrameLimiter
+};
+
+/**
+ * FrameLimiter - Frame pacing and frame-time statistics for the main loop
+ *
+ * Features:
+ * - CAPPED mode waits out each frame against a fixed deadline: it sleeps
+ *   until FRAME_SPIN_THRESHOLD_MS before the deadline, then spins on the
+ *   performance counter, which is precise where SDL_Delay isn't
+ * - Deadlines advance by exactly one period, so the average rate stays on
+ *   target; a frame that finishes late doesn't make the next ones rush
+ * - Running mean, variance and worst case of the frame time (Welford's
+ *   method, no history kept) and a count of missed deadlines. For VSYNC a
+ *   frame longer than FRAME_MISSED_TOLERANCE refresh periods counts as a
+ *   missed deadline.
+ *
+ * The limiter doesn't switch VSync itself; the renderer's owner does.
+ *
+ * Usage:
+ * FrameLimiter limiter(PacingMode::CAPPED, 144);
+ * while (running) { update(); render(); present(); limiter.endFrame(); }
+ */
+class FrameLimiter {
+public:
+  struct Stats {
+    Uint64 frames = 0;
+    double meanMs = 0.0;      // Average frame time
+    double varianceMs2 = 0.0; // Frame time variance
+    double worstMs = 0.0;     // Longest frame
+    Uint64 missedDeadlines = 0;
+  };
+
+  explicit FrameLimiter(PacingMode mode = PacingMode::VSYNC,
+                        int targetFps = FRAME_CAP_DEFAULT_FPS);
+
+  /**
+   * Switch pacing; starts a fresh baseline and fresh statistics
+   * @param targetFps Frame rate for CAPPED (0 keeps the current one)
+   */
+  void setMode(PacingMode mode, int targetFps = 0);
+  PacingMode getMode() const { return mode; }
+  int getTargetFps() const { return targetFps; }
+
+  // Display refresh rate, used to judge VSync frames (0 = unknown)
+  void setRefreshRate(int hz);
+
+  /**
+   * Call once per frame, right after presenting: waits until the frame's
+   * deadline when CAPPED, then records the frame time
+   * @param whileWaiting Called about every millisecond of the sleep (e.g.
+   *        to poll events), never during the final spin
+   */
+  void endFrame(const std::function<void()> &whileWaiting = nullptr);
+
+  /**
+   * Forget the previous frame, e.g. after the loop slept while idle, so the
+   * gap counts neither as a frame nor as a missed deadline
+   */
+  void reset();
+
+  const Stats &getStats() const { return stats; }
+  void resetStats() {
+    stats = Stats();
+    sumSquares = 0.0;
+  }
+
+  static const char *modeName(PacingMode mode);
+
+  /**
+   * Parse a pacing option: "vsync", "uncapped" or a frame rate ("60")
+   * @return false if the text is none of these
+   */
+  static bool parseMode(const std::string &text, PacingMode &mode,
+                        int &targetFps);
+
+private:
+  PacingMode mode;
+  int targetFps;
+  Uint64 frequency;         // Performance counter ticks per second
+  Uint64 period = 0;        // Counter ticks per capped frame
+  Uint64 refreshPeriod = 0; // Counter ticks per display refresh
+  Uint64 deadline = 0;      // End of the current capped frame (0 = none)
+  Uint64 lastFrame = 0;     // Counter at the previous endFrame() (0 = none)
+  double sumSquares = 0.0;  // Welford accumulator behind the variance
+  Stats stats;
+
+  // Sleep, then spin, until the deadline; false if it had already passed
+  bool waitForDeadline(const std::function<void()> &whileWaiting);
+  void record(Uint64 frameTicks);
+};
+
+#endif // FRAME_LIMITER_H
@@ -3,15 +3,32 @@
 #define GAME_H
 
 #include "config.h"
+#include "entity_systems.h"
+#include "frame_limiter.h"
+#include "input_buffer.h"
+#include "job_system.h"
 #include "map.h"
+#include "particle_system.h"
 
 #include "audio_manager.h"
 #include "platform.h"
 #include "player.h"
+#include "render_cache.h"
+#include "render_snapshot.h"
+#include "replay.h"
+#include "rewind_buffer.h"
+#include "spsc_queue.h"
+#include "text_renderer.h"
+#include "texture_cache.h"
+#include "triple_buffer.h"
 #include <SDL2/SDL_image.h>
 #include <SDL2/SDL_mixer.h>
 #include <SDL2/SDL_ttf.h>
+#include <atomic>
+#include <condition_variable>
 #include <memory>
+#include <mutex>
+#include <thread>
 /**
  * SubSystemWrapper - RAII wrapper for SDL subsystem initialization and cleanup
  *
@@ -88,6 +105,14 @@ public:
  *
  * Design pattern: This follows a simple game object architecture where
  * the Game class acts as the main controller/manager
+ *
+ * Threads:
+ * - The main thread owns the window and renderer: it polls events, samples
+ *   the keyboard and draws the latest RenderSnapshot
+ * - The simulation thread steps the world at SIMULATION_TICK_RATE, drives
+ *   audio, and publishes a snapshot after every step through a TripleBuffer
+ * - Pause/restart requests go to the simulation through a command queue;
+ *   the world itself is only ever touched by the simulation thread
  */
 class Game {
 public:
@@ -119,9 +144,43 @@ public:
    */
   void handleEvents(SDL_Event &e);
 
+  // Handle one event
+  void handleEvent(const SDL_Event &e);
+
   void playerInit(SDL_Rect rect, std::shared_ptr<Texture> texture);
   void init();
 
+  /**
+   * Choose the audio output before run() (e.g. NullAudioBackend for
+   * headless runs). Defaults to SDL_mixer.
+   */
+  void setAudioBackend(std::unique_ptr<AudioBackend> backend) {
+    audioBackend = std::move(backend);
+  }
+
+  /**
+   * Choose how frames are paced; may be called before or during run()
+   * @param targetFps Frame rate for PacingMode::CAPPED (0 keeps the current
+   *        one)
+   */
+  void setPacing(PacingMode mode, int targetFps = 0);
+
+  /**
+   * Record every tick's input and state hash; the replay is written to
+   * path when run() returns. Call before run().
+   */
+  void recordReplay(const std::string &path) { recordPath = path; }
+
+  /**
+   * Drive the game from a recorded replay instead of the keyboard. Call
+   * before run(). Each tick's state is checked against the recording and
+   * desyncs are reported.
+   * @param fastForward Run the ticks back to back instead of in real time,
+   *        and quit at the end (headless benchmark runs)
+   * @return false if the replay can't be read
+   */
+  bool playReplay(const std::string &path, bool fastForward);
+
 private:
   // === SDL Core Objects ===
   SubSystemWrapper sdlSubsystem;
@@ -137,6 +196,10 @@ private:
   // === Timing and Performance ===
   Uint64 perfFreq; // SDL performance counter frequency (for delta time
                    // calculation)
+  FrameLimiter frameLimiter; // Main loop pacing and frame-time statistics
+
+  // Print the frame-time statistics of the current pacing mode
+  void logPacingStats() const;
   const char *playerTexturePath; // Path to player texture file
 
   // === Scaling and Resolution ===
@@ -144,17 +207,143 @@ private:
   int targetHeight; // Target logical resolution height
 
   // === Game State ===
-  bool isRunning = false; // Main game loop control flag
-  bool isPaused = false;  // Pause state control flag
-  bool hasWon = false;    // Win state control flag
+  std::atomic<bool> isRunning{false}; // Main game loop control flag
+  // Simulation thread only; the main thread sees them through snapshots
+  bool isPaused = false; // Pause state control flag
+  bool hasWon = false;   // Win state control flag
+
+  // === Idle Mode ===
+  // Nothing visible changes while paused, won, hidden or unfocused: the
+  // loop then sleeps on the event queue and redraws only when asked
+  bool windowHidden = false;  // Minimized or hidden
+  bool windowFocused = true;  // Has keyboard focus
+  bool needsRedraw = true;    // Something visible changed while idle
+  bool isIdle(const RenderSnapshot &shown) const {
+    return shown.paused || shown.won || windowHidden || !windowFocused;
+  }
+
+  // === Simulation Thread ===
+  // Requests from the main thread, applied at the start of a tick
+  enum class GameCommand { TOGGLE_PAUSE, RESTART };
+
+  std::thread simulationThread;
+  TripleBuffer<RenderSnapshot> snapshots; // Simulation -> main thread
+  SpscQueue<GameCommand, 16> commands;    // Main thread -> simulation
+  InputBuffer input;                      // Key events -> simulation
+  InputBuffer::Frame tickInput;           // This tick's input (simulation)
+  std::atomic<bool> simulationActive{true}; // Window shown and focused
+  std::mutex simulationMutex;               // Guards the idle wait only
+  std::condition_variable simulationWake;
+  Uint64 simulationTick = 0;
+  bool publishedPaused = false; // Flags of the last published snapshot
+  bool publishedWon = false;
+  // SDL user event the simulation posts when pause/win changes, so an idle
+  // main thread redraws straight away
+  Uint32 snapshotEvent = static_cast<Uint32>(-1);
+
+  /**
+   * Simulation thread body: fixed-rate ticks until isRunning is cleared.
+   * Sleeps while paused, won or while the window is inactive.
+   */
+  void simulationLoop();
+
+  /**
+   * Advance the world by one tick (simulation thread)
+   * @param dt Tick length in seconds
+   */
+  void simulate(float dt);
+
+  // Step the world itself: player, entities, platforms, collisions
+  void advanceWorld(float dt);
+
+  /**
+   * Apply queued commands (simulation thread)
+   * @return true if the pause or win state changed
+   */
+  bool applyCommands();
+
+  // Copy the drawable world into the next snapshot and hand it over
+  void publishSnapshot();
+
+  // Send a command to the simulation thread and wake it
+  void sendCommand(GameCommand command);
+
+  // Wake the simulation thread from its idle wait
+  void wakeSimulation();
+
+  // Stop and join the simulation thread (safe to call twice)
+  void stopSimulation();
+
+  // Print how long key events took to reach the simulation
+  void logInputLatency() const;
+
+  // === Replays (simulation thread) ===
+  std::string recordPath; // Empty: not recording
+  Replay recording;
+  Replay replay;
+  bool replaying = false;
+  bool replayFastForward = false;
+  size_t replayTick = 0;     // Next tick of the replay to play
+  Uint64 replayDesyncs = 0;  // Ticks whose state hash didn't match
+  Uint64 replayStarted = 0;  // Performance counter at the first tick
+  Uint16 pendingReplayFlags = 0; // Pause/restart since the previous tick
+
+  // Nothing may tick: paused, or won and not about to be restarted by the
+  // replay
+  bool simulationFrozen() const;
+
+  // Hash of the state a replay must reproduce
+  Uint32 stateHash();
+
+  // Bookkeeping after each tick: record, or compare with the replay
+  void replayTickDone(Uint16 input);
+
+  // Print the outcome of a replay and hand control back (or quit)
+  void finishReplay();
+
+  // === Rewind (simulation thread) ===
+  RewindBuffer rewindHistory{REWIND_SECONDS * SIMULATION_TICK_RATE,
+                             REWIND_KEYFRAME_INTERVAL};
+  std::vector<Uint8> rewindState; // Capture/restore buffer, reused
+
+  // Append the world's state to the history (finite maps only)
+  void captureRewindState();
+
+  /**
+   * Restore the world as it was a few ticks ago, discarding the newer
+   * history. Holds on the oldest state once the history runs out.
+   * @return false if there is no history (the world advances instead)
+   */
+  bool rewindWorld(size_t ticks);
+
+  // Player contacts found in the parallel phase of a tick, one per collider
+  std::vector<EntitySystems::Contact> entityContacts;
+
+  /**
+   * Collide the player with every coin and arrow: overlaps are found in
+   * parallel, then applied serially in collider order so coin counts,
+   * deaths and sounds come out the same on any core count
+   */
+  void collideEntities();
+
+  // === Particles (simulation thread) ===
+  // Bursts for coin pickups, deaths and dashes; visual only
+  ParticleSystem particles;
+  ParticleSystem::Pool coinParticles = 0;
+  ParticleSystem::Pool deathParticles = 0;
+  ParticleSystem::Pool dashParticles = 0;
+  std::unique_ptr<Texture> particleTexture;
+
+  // Create the particle texture and one pool per effect
+  void initParticles();
 
   // === Game World ===
   SDL_Rect floor = {0, 300, 800, 50};   // Static floor collision rectangle
   SDL_Rect floor2 = {200, 260, 50, 50}; // Static floor collision rectangle
 
   /**
-   * Update player position based on keyboard input
-   * @param dt Delta time in seconds since last frame
+   * Update player position based on this tick's input
+   * @param dt Delta time in seconds since last tick
    *
    * Input mapping:
    * - A/Left Arrow: Move left
@@ -164,7 +353,7 @@ private:
    * - Left Shift: Dash (applies dash multiplier)
    * - Left Control: Crouch (reduces hitbox size)
    *
-   * Also handles collision detection with the floor
+   * Then moves the player through the tiles with TileMover
    */
   void updatePlayerPos(float dt);
 
@@ -193,13 +382,35 @@ private:
    */
   std::shared_ptr<AudioManager> audioManager;
 
+  // === Worker Threads ===
+  std::shared_ptr<JobSystem> jobSystem; // Loading and per-tick parallel work
+  std::shared_ptr<TextureCache> textureCache; // Shared image textures
+  std::unique_ptr<AudioBackend> audioBackend; // Output for init(), if set
+
   // === Font Resources ===
-  std::unique_ptr<TTF_Font, void (*)(TTF_Font *)> font;
+  // Glyph atlas for all on-screen text; null if no font could be loaded
+  std::unique_ptr<TextRenderer> text;
+
+  // === Cached Frames ===
+  // While paused or won nothing moves: the last world frame and the static
+  // overlay are each drawn once and then only copied
+  std::unique_ptr<RenderCache> frozenWorld;
+  std::unique_ptr<RenderCache> pauseOverlay;
+  std::unique_ptr<RenderCache> winOverlay;
+
+  /**
+   * Draw a snapshot of the map and player over a cleared background
+   */
+  void renderWorld(const RenderSnapshot &snapshot);
+
+  // Redraw every cached frame (resize, content change)
+  void invalidateRenderCaches();
 
   /**
-   * Render text to a texture
+   * Draw and present one frame
+   * @param snapshot Latest state published by the simulation
    */
-  SDL_Texture *renderText(const char *text, SDL_Color color);
+  void renderFrame(const RenderSnapshot &snapshot);
 };
 
 #endif // GAME_H
\ No newline at end of file
@@ -0,0 +1,96 @@
+#ifndef INPUT_BUFFER_H
+#define INPUT_BUFFER_H
+
+#include "spsc_queue.h"
+#include <SDL2/SDL.h>
+
+// Game actions, one bit each; keys map onto them in InputBuffer::actionFor()
+enum InputAction : Uint32 {
+  INPUT_MOVE_LEFT = 1u << 0,
+  INPUT_MOVE_RIGHT = 1u << 1,
+  INPUT_JUMP = 1u << 2,
+  INPUT_FAST_FALL = 1u << 3,
+  INPUT_DASH = 1u << 4,
+  INPUT_CROUCH = 1u << 5,
+  INPUT_REWIND = 1u << 6,
+};
+
+/**
+ * InputBuffer - Timestamped key events handed from the event thread to the
+ * simulation, one batch per tick
+ *
+ * Features:
+ * - The main thread records every press and release as it is polled,
+ *   stamped with the time SDL received it (converted to the performance
+ *   counter)
+ * - The simulation calls consume() once per tick and gets the held
+ *   actions plus every press and release since the previous tick. Edges are
+ *   delivered exactly once, so a tap that starts and ends between two ticks
+ *   still shows up as a press.
+ * - Tracks event-to-simulation latency: from the event's timestamp to the
+ *   tick that consumed it
+ *
+ * record() must only be called from one thread and consume() from one
+ * (other) thread.
+ *
+ * Usage:
+ * input.record(InputBuffer::actionFor(key), true, e.key.timestamp); // events
+ * InputBuffer::Frame frame = input.consume();                     // per tick
+ * if (frame.isDown(INPUT_JUMP)) jump();
+ */
+class InputBuffer {
+public:
+  // What one tick sees
+  struct Frame {
+    Uint32 held = 0;     // Down at the end of the batch
+    Uint32 pressed = 0;  // Went down since the last tick
+    Uint32 released = 0; // Went up since the last tick
+
+    // Held now, or tapped since the last tick
+    bool isDown(Uint32 action) const { return (held | pressed) & action; }
+  };
+
+  struct Latency {
+    Uint64 events = 0;
+    double lastMs = 0.0;
+    double meanMs = 0.0;
+    double worstMs = 0.0;
+  };
+
+  InputBuffer();
+
+  // Action bit for a key, 0 if the key isn't bound
+  static Uint32 actionFor(SDL_Scancode key);
+
+  /**
+   * Record a press or release (producer thread)
+   * @param sdlTimestamp The event's timestamp (ms, SDL_GetTicks() clock)
+   * @return false if the buffer is full and the event was dropped
+   */
+  bool record(Uint32 action, bool pressed, Uint32 sdlTimestamp);
+
+  /**
+   * Take every event recorded since the last call (consumer thread)
+   */
+  Frame consume();
+
+  // Latency of consumed events (consumer thread, or after it stopped)
+  const Latency &getLatency() const { return latency; }
+
+private:
+  struct Event {
+    Uint32 action;
+    bool pressed;
+    Uint64 time; // Performance counter
+  };
+
+  SpscQueue<Event, 256> events;
+  Uint64 frequency;
+  // Consumer side. Several keys can share an action, so an action stays
+  // held until its last key goes up.
+  Uint32 held = 0;
+  Uint8 keysDown[32] = {}; // Keys down per action bit
+  Latency latency;
+};
+
+#endif // INPUT_BUFFER_H
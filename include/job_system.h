@@ -0,0 +1,168 @@
+#ifndef JOB_SYSTEM_H
+#define JOB_SYSTEM_H
+
+#include <atomic>
+#include <condition_variable>
+#include <cstddef>
+#include <deque>
+#include <exception>
+#include <functional>
+#include <future>
+#include <memory>
+#include <mutex>
+#include <thread>
+#include <type_traits>
+#include <vector>
+
+/**
+ * JobSystem - Work-stealing scheduler for loading jobs and per-tick
+ * data-parallel updates
+ *
+ * Features:
+ * - One deque per thread: a thread takes its newest job from the back of
+ *   its own deque and, when that is empty, steals the oldest job from the
+ *   front of another thread's
+ * - parallelFor() splits a range in halves on demand: the running half
+ *   stays on the current thread, the other half is left to be stolen, so
+ *   idle cores pick up work without a central queue
+ * - The calling thread works too instead of blocking, and ranges no larger
+ *   than the batch size run inline with no scheduling at all
+ * - No allocations per element: a range is split in place into small job
+ *   structs and the loop body is referenced from the caller's stack. The
+ *   deques may still allocate blocks as they grow, and submit() allocates
+ *   its task, so neither is allocation-free.
+ * - The first exception thrown by the body is rethrown to the caller
+ * - submit() queues a one-off job (level loading, asset decodes) on the
+ *   same workers and returns a std::future holding its result or exception
+ *
+ * The body must only touch state owned by its own indices; anything that
+ * crosses entities belongs in a serial pass after parallelFor() returns.
+ *
+ * Usage:
+ * JobSystem jobs;
+ * auto layer = jobs.submit([] { return buildLayer(); });
+ * jobs.parallelFor(items.size(), 256, [&](size_t begin, size_t end) {
+ *   for (size_t i = begin; i < end; ++i) items[i].update(dt);
+ * });
+ */
+class JobSystem {
+public:
+  /**
+   * Start the worker threads
+   * @param threadCount Number of workers (0 = one per hardware thread,
+   *        minus the thread that calls parallelFor())
+   */
+  explicit JobSystem(size_t threadCount = 0);
+
+  /**
+   * Finish the queued submit() jobs, then stop and join the workers. No
+   * parallelFor() may be in flight.
+   */
+  ~JobSystem();
+
+  /**
+   * Run body(begin, end) over sub-ranges covering [0, count) and wait for
+   * all of them
+   * @param batchSize Smallest range worth handing to another thread
+   * @param body Callable taking (size_t begin, size_t end)
+   */
+  template <typename F>
+  void parallelFor(size_t count, size_t batchSize, F &&body) {
+    if (count == 0)
+      return;
+    if (batchSize == 0)
+      batchSize = 1;
+    if (count <= batchSize || workers.empty()) {
+      body(size_t(0), count);
+      return;
+    }
+
+    Loop loop;
+    loop.body = &body;
+    loop.invoke = [](const void *f, size_t begin, size_t end) {
+      (*static_cast<std::remove_reference_t<F> *>(const_cast<void *>(f)))(
+          begin, end);
+    };
+    loop.batchSize = batchSize;
+    run(loop, count);
+  }
+
+  /**
+   * Queue a job for a worker thread (runs inline if there are no workers)
+   * @param job Callable taking no arguments
+   * @return Future holding the job's return value (or exception)
+   */
+  template <typename F>
+  auto submit(F &&job) -> std::future<std::invoke_result_t<std::decay_t<F>>> {
+    using Result = std::invoke_result_t<std::decay_t<F>>;
+    auto task =
+        std::make_shared<std::packaged_task<Result()>>(std::forward<F>(job));
+    std::future<Result> result = task->get_future();
+    if (workers.empty()) {
+      (*task)();
+    } else {
+      push(currentQueue(),
+           Job{nullptr, 0, 0,
+               new std::function<void()>([task]() { (*task)(); })});
+    }
+    return result;
+  }
+
+  /**
+   * Number of worker threads (not counting callers)
+   */
+  size_t size() const { return workers.size(); }
+
+  // Non-copyable, non-movable: workers hold a pointer to this system
+  JobSystem(const JobSystem &) = delete;
+  JobSystem &operator=(const JobSystem &) = delete;
+  JobSystem(JobSystem &&) = delete;
+  JobSystem &operator=(JobSystem &&) = delete;
+
+private:
+  // One parallelFor() call, living on the caller's stack
+  struct Loop {
+    const void *body = nullptr;
+    void (*invoke)(const void *, size_t, size_t) = nullptr;
+    size_t batchSize = 1;
+    std::atomic<size_t> pending{0}; // Jobs queued or running
+    std::mutex errorMutex;
+    std::exception_ptr error;
+  };
+
+  // A range of a parallelFor() loop, or a submitted task (owned, run once)
+  struct Job {
+    Loop *loop;
+    size_t begin;
+    size_t end;
+    std::function<void()> *task;
+  };
+
+  struct WorkQueue {
+    std::mutex mutex;
+    std::deque<Job> jobs;
+  };
+
+  std::vector<std::thread> workers;
+  // One per worker, plus a shared one for threads outside the system
+  std::vector<std::unique_ptr<WorkQueue>> queues;
+
+  std::atomic<size_t> queuedJobs{0}; // Jobs sitting in any deque
+  std::mutex sleepMutex;
+  std::condition_variable workAvailable;
+  bool stopping = false;
+
+  void run(Loop &loop, size_t count);
+  void workerLoop(size_t index);
+
+  size_t currentQueue() const;
+  void push(size_t queue, const Job &job);
+  bool pop(size_t queue, Job &job);
+  bool steal(size_t thief, Job &job);
+  bool findJob(size_t queue, Job &job);
+
+  // Run a job, splitting off halves for other threads while it is large
+  void execute(size_t queue, Job job);
+};
+
+#endif // JOB_SYSTEM_H
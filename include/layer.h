@@ -3,14 +3,18 @@
 #include "collideable.h"
 #include "config.h"
 #include "platform.h"
+#include "render_snapshot.h"
 #include "texture.h"
 #include "tmx_parser.h"
 #include "trap_platform.h"
 #include <SDL2/SDL.h>
 #include <memory>
 #include <string>
+#include <unordered_map>
 #include <vector>
 
+class TileAnimator;
+
 class Layer {
 public:
   Layer(const std::string &name, int width, int height, int tileSizeW,
@@ -39,6 +43,8 @@ public:
   // Tile management
   void setTile(int x, int y, std::shared_ptr<Platform> tile);
   std::shared_ptr<Platform> getTile(int x, int y) const;
+  // Same lookup without the shared_ptr copy, for per-tile hot loops
+  const Platform *tileAt(int x, int y) const;
   void removeTile(int x, int y);
   void clearTiles();
 
@@ -48,14 +54,63 @@ public:
   getTilesInRect(const SDL_FRect &rect) const;
   std::vector<std::shared_ptr<Platform>> getAllTiles() const;
 
-  // Rendering
-  void render(SDL_Renderer *renderer) const;
+  // Rendering. Animated tiles show the animator's current frame.
+  void render(RenderSnapshot &snapshot,
+              const TileAnimator *animator = nullptr) const;
 
   // Layer data loading from TMX
   void loadFromTMXLayer(
       const TMXParser::Layer &tmxLayer,
       const std::vector<TMXParser::TilesetInfo> &tilesets,
-      const std::vector<std::shared_ptr<Texture>> &tilesetTextures);
+      const std::vector<std::shared_ptr<Texture>> &tilesetTextures,
+      const TileAnimator *animator = nullptr);
+
+  /**
+   * Build the platform for one GID at tile (tx, ty)
+   * @param animator Gives animated GIDs their slot (optional)
+   * @return The tile, or nullptr for empty GIDs / missing tilesets
+   */
+  static std::shared_ptr<Platform>
+  createTile(int gid, int tx, int ty, int tileSizeW, int tileSizeH,
+             const std::vector<TMXParser::TilesetInfo> &tilesets,
+             const std::vector<std::shared_ptr<Texture>> &tilesetTextures,
+             const TileAnimator *animator = nullptr);
+
+  // Source rect of a tileset's local tile id
+  static SDL_Rect tileSrcRect(const TMXParser::TilesetInfo &tileset,
+                              int localId);
+
+  // === Chunked storage (infinite maps) ===
+  // In chunked mode tiles live in fixed-size chunks that are installed and
+  // removed as the world streams; only resident chunks are queried/rendered.
+  void enableChunks(int chunkWidth, int chunkHeight);
+  bool isChunked() const { return chunked; }
+  int getChunkWidth() const { return chunkWidth; }
+  int getChunkHeight() const { return chunkHeight; }
+
+  /**
+   * Install a chunk's tiles
+   * @param cx, cy Chunk coordinates (in chunks, not tiles)
+   * @param chunkTiles chunkWidth * chunkHeight tiles in row-major order
+   */
+  void setChunk(int cx, int cy,
+                std::vector<std::shared_ptr<Platform>> chunkTiles);
+  void removeChunk(int cx, int cy);
+  bool hasChunk(int cx, int cy) const;
+
+  // Built unsigned: shifting a negative signed value is undefined
+  static long long chunkKey(int cx, int cy) {
+    return static_cast<long long>(
+        (static_cast<unsigned long long>(static_cast<unsigned int>(cx))
+         << 32) |
+        static_cast<unsigned int>(cy));
+  }
+
+  // Floor division that stays correct for negative tile coordinates
+  static int floorDiv(int a, int b) {
+    int q = a / b;
+    return (a % b != 0 && ((a < 0) != (b < 0))) ? q - 1 : q;
+  }
 
 private:
   std::string name;
@@ -70,7 +125,19 @@ private:
 
   std::vector<std::shared_ptr<Platform>> tiles;
 
+  // Chunked storage
+  bool chunked = false;
+  int chunkWidth = 0;
+  int chunkHeight = 0;
+  std::unordered_map<long long, std::vector<std::shared_ptr<Platform>>>
+      chunks;
+
   // Helper methods
   size_t getIndex(int x, int y) const;
   void worldToTile(int wx, int wy, int &tx, int &ty) const;
+  std::shared_ptr<Platform> *tileSlot(int x, int y);
+  const std::shared_ptr<Platform> *tileSlot(int x, int y) const;
+  void renderTile(RenderSnapshot &snapshot,
+                  const std::shared_ptr<Platform> &tile,
+                  const TileAnimator *animator) const;
 };
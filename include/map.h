@@ -1,20 +1,26 @@
 #pragma once
 
-#include "audio_manager.h"
+#include "chunk_streamer.h"
 #include "collideable.h"
 #include "config.h"
 #include "disappearing_platform.h"
+#include "entity_registry.h"
+#include "job_system.h"
 #include "layer.h"
 #include "platform.h"
-#include "projectile.h"
+#include "render_snapshot.h"
+#include "state_stream.h"
 #include "sprite.h"
 #include "texture.h"
+#include "texture_cache.h"
+#include "tile_animator.h"
 #include "tmx_parser.h"
 #include "trap_platform.h"
 #include <SDL2/SDL.h>
 #include <memory>
 #include <sstream>
 #include <unordered_map>
+#include <unordered_set>
 #include <vector>
 class Map {
 public:
@@ -33,6 +39,9 @@ public:
   // Preferred explicit getters
   int getTileWidth() const { return tileSizeW; }
   int getTileHeight() const { return tileSizeH; }
+  // World-space extent: the map, or the whole chunk index of an infinite
+  // map (which may start at negative coordinates)
+  SDL_FRect getWorldBounds() const;
 
   // Layer management
   int getLayerCount() const;
@@ -58,17 +67,23 @@ public:
   std::vector<std::shared_ptr<Platform>>
   getTilesInRect(const SDL_FRect &rect) const;
   std::vector<std::shared_ptr<Platform>> getAllTiles() const;
+  // Whether tile (tx, ty) blocks movement: a tile on a collidable layer or
+  // a disappearing platform that is still solid. Traps don't block; they
+  // hurt on overlap instead (isPlayerOnTrapLayer).
+  bool isSolid(int tx, int ty) const;
 
   // rendering
-  void render(SDL_Renderer *renderer, float dt) const;
-  void renderLayer(SDL_Renderer *renderer, int index) const;
-
-  // projectile management
-  void updateProjectiles(float dt);
-  void removeDeadProjectiles();
-  std::vector<std::shared_ptr<Projectile>> &getProjectiles() {
-    return projectiles;
-  }
+  // Record the layers, visible platforms and entities, back to front
+  void render(RenderSnapshot &snapshot) const;
+  void renderLayer(RenderSnapshot &snapshot, int index) const;
+
+  // Dynamic entities (coins, arrows): run their per-tick systems
+  void updateEntities(float dt);
+  EntityRegistry &getEntities() { return registry; }
+  const EntityRegistry &getEntities() const { return registry; }
+
+  // Advance the shared clock of the animated tile types
+  void updateTileAnimations(float dt) { tileAnimator.update(dt); }
 
   // special platform management
   void updateDisappearingPlatforms(float dt);
@@ -83,13 +98,90 @@ public:
   int getCollectedCoins() const { return collectedCoins; }
   bool areAllCoinsCollected() const { return collectedCoins >= totalCoins; }
   void collectCoin() { collectedCoins++; }
+  // Bring every collected coin back
   void resetCoins();
 
-  void setAudioManager(std::shared_ptr<AudioManager> audioManager) {
-    this->audioManager = audioManager;
+  // Rewind (finite maps only): coin count, the entity registry and every
+  // disappearing platform. Loading reuses the existing entities and
+  // doesn't allocate.
+  bool canSaveState() const { return !infinite; }
+  void saveState(StateWriter &out) const;
+  void loadState(StateReader &in);
+
+  // Scheduler for building layers in init() and for the per-tick entity
+  // updates. Without one, init() creates a temporary one for the load and
+  // the updates run serially.
+  void setJobSystem(std::shared_ptr<JobSystem> jobSystem) {
+    this->jobSystem = jobSystem;
   }
 
+  // Cache tileset textures are loaded through; a temporary cache is used
+  // for the load if none is set
+  void setTextureCache(std::shared_ptr<TextureCache> textureCache) {
+    this->textureCache = textureCache;
+  }
+
+  // World streaming for infinite maps: loads chunks around the focus and
+  // evicts far ones. Call once per frame before querying tiles; does nothing
+  // for finite maps.
+  void updateStreaming(const SDL_FRect &focus);
+  bool isInfinite() const { return infinite; }
+
 private:
+  /**
+   * Everything produced from one TMX layer. Built on a worker thread and
+   * merged into the map in layer order on the calling thread.
+   */
+  struct LayerBuild {
+    std::unique_ptr<Layer> layer;
+    bool keepLayer = true; // false for layers fully converted to entities
+    std::vector<EntitySpawn> spawns;
+    std::vector<std::shared_ptr<DisappearingPlatform>> disappearingPlatforms;
+
+    // Coin layer data
+    bool isCoinLayer = false;
+    int coinCount = 0;
+  };
+
+  // Build a layer and extract its special objects (coins, traps, arrows,
+  // disappearing platforms). Only reads map state, so it is safe to run
+  // concurrently for different layers.
+  LayerBuild
+  buildLayer(const TMXParser::Layer &layerInfo,
+             const std::vector<TMXParser::TilesetInfo> &tilesetInfo) const;
+
+  // Convert a plain tile into its special object. Shared by buildLayer and
+  // buildChunk, so these must stay thread-safe.
+  EntitySpawn makeCoin(const std::shared_ptr<Platform> &tile) const;
+  EntitySpawn makeArrow(const std::shared_ptr<Platform> &tile) const;
+  std::shared_ptr<TrapPlatform>
+  makeTrap(const std::shared_ptr<Platform> &tile) const;
+  std::shared_ptr<DisappearingPlatform>
+  makeDisappearing(const std::shared_ptr<Platform> &tile) const;
+
+  // Infinite maps: set up chunked layers and the streamer from the chunk
+  // index
+  void initStreaming(const std::vector<TMXParser::TilesetInfo> &tilesetInfo,
+                     const std::vector<TMXParser::Layer> &layersInfo);
+
+  // Build one chunk's tiles and special objects. Runs on the streaming
+  // thread; reads only state that is fixed after init.
+  void buildChunk(const ChunkRequest &request, const std::vector<int> &gids,
+                  ChunkLoad &load) const;
+
+  // Create the registry entity for a spawn description (owner thread)
+  Entity spawn(const EntitySpawn &description);
+
+  // Add/remove a streamed chunk's tiles and objects (owner thread)
+  void installChunk(ChunkLoad &load);
+  void uninstallChunk(const ChunkId &id);
+
+  // Objects a resident chunk added to the map, removed again on eviction
+  struct ChunkEntities {
+    std::vector<Entity> entities;
+    std::vector<std::shared_ptr<DisappearingPlatform>> disappearingPlatforms;
+  };
+
   TMXParser tmxParser;
   int width;
   int height;
@@ -102,22 +194,51 @@ private:
   // Tileset textures (shared across layers)
   std::vector<std::shared_ptr<Texture>> tilesetTextures;
 
+  // Animated tile types; fixed after init, so chunk builds can read it
+  TileAnimator tileAnimator;
+
   std::vector<std::shared_ptr<Platform>>
       tiles; // Deprecated, use layers instead but it causes errors when removed
              // so...
 
-  std::vector<std::shared_ptr<Projectile>> projectiles;
+  // Coins and arrows. Collected coins are disabled, not destroyed, so they
+  // can respawn and be rewound without allocating.
+  EntityRegistry registry;
   std::vector<std::shared_ptr<DisappearingPlatform>> disappearingPlatforms;
+  // The same platforms by tile (Layer::chunkKey of the tile coordinates),
+  // so isSolid doesn't scan the list
+  std::unordered_map<long long, const DisappearingPlatform *>
+      disappearingTiles;
+  long long tileKeyOf(const Platform &platform) const;
 
   // Coin tracking for win condition
   int totalCoins = 0;
   int collectedCoins = 0;
-  std::vector<SDL_FRect>
-      originalCoinBounds; // Store original coin bounds (position and size)
-  std::shared_ptr<Texture> coinTexture; // Store coin texture for respawning
-  SDL_Rect coinSrcRect; // Store coin sprite source rect for respawning
 
-  std::shared_ptr<AudioManager>
-      audioManager;                // Optional audio manager for sound effects
+  std::shared_ptr<TextureCache> textureCache; // Optional shared textures
+  std::shared_ptr<JobSystem> jobSystem; // Optional parallel loads/updates
+
+  // Run update(begin, end) over [0, count), in parallel if possible
+  template <typename F> void forEachEntity(size_t count, F &&update) {
+    if (jobSystem)
+      jobSystem->parallelFor(count, ENTITY_UPDATE_BATCH_SIZE, update);
+    else
+      update(size_t(0), count);
+  }
+
+  // World streaming state (infinite maps only)
+  bool infinite = false;
+  int originTileX = 0; // Top-left tile of the chunk extent
+  int originTileY = 0;
+  int coinLayerIndex = -1;
+  std::vector<TMXParser::TilesetInfo> streamTilesets;
+  std::vector<std::string> streamLayerNames;
+  std::unordered_map<ChunkId, ChunkEntities, ChunkIdHash> chunkEntities;
+  std::unordered_map<Entity, long long>
+      coinTiles; // Streamed coin -> its tile key
+  std::unordered_set<long long>
+      collectedCoinTiles; // Stay collected across eviction
+  std::unique_ptr<ChunkStreamer> chunkStreamer; // Uses the state above
+
   std::shared_ptr<Texture> assets; // Optional texture for rendering
 };
@@ -0,0 +1,73 @@
+#ifndef PACK_FORMAT_H
+#define PACK_FORMAT_H
+
+#include <cstddef>
+#include <cstdint>
+
+/**
+ * PackFormat - On-disk layout of the resource pack (resources.pak)
+ *
+ * All integers are little-endian.
+ *
+ *   Header                 16 bytes
+ *   Entry[entryCount]      24 bytes each, sorted by name
+ *   names                  UTF-8, not terminated, referenced by entries
+ *   data                   each file starts on a DATA_ALIGNMENT boundary
+ *
+ * Names are paths relative to the resource root with '/' separators, e.g.
+ * "sounds/jump.wav". Written by tools/pack_resources.cpp, read by Vfs.
+ * Depends only on the standard library so the pack tool can share it.
+ */
+namespace PackFormat {
+
+constexpr char MAGIC[4] = {'R', 'B', 'P', 'K'};
+constexpr std::uint32_t VERSION = 1;
+constexpr std::uint64_t DATA_ALIGNMENT = 16;
+
+constexpr size_t HEADER_SIZE = 16; // magic, version, entryCount, reserved
+constexpr size_t ENTRY_SIZE = 24;  // offset, size, nameOffset, nameLength
+
+struct Entry {
+  std::uint64_t offset;     // File data, from the start of the pack
+  std::uint64_t size;       // File data bytes
+  std::uint32_t nameOffset; // Name, from the start of the pack
+  std::uint32_t nameLength;
+};
+
+inline std::uint32_t readU32(const unsigned char *bytes) {
+  return static_cast<std::uint32_t>(bytes[0]) |
+         static_cast<std::uint32_t>(bytes[1]) << 8 |
+         static_cast<std::uint32_t>(bytes[2]) << 16 |
+         static_cast<std::uint32_t>(bytes[3]) << 24;
+}
+
+inline std::uint64_t readU64(const unsigned char *bytes) {
+  return static_cast<std::uint64_t>(readU32(bytes)) |
+         static_cast<std::uint64_t>(readU32(bytes + 4)) << 32;
+}
+
+inline void writeU32(unsigned char *bytes, std::uint32_t value) {
+  for (int i = 0; i < 4; ++i)
+    bytes[i] = static_cast<unsigned char>(value >> (8 * i));
+}
+
+inline void writeU64(unsigned char *bytes, std::uint64_t value) {
+  writeU32(bytes, static_cast<std::uint32_t>(value));
+  writeU32(bytes + 4, static_cast<std::uint32_t>(value >> 32));
+}
+
+inline Entry readEntry(const unsigned char *bytes) {
+  return Entry{readU64(bytes), readU64(bytes + 8), readU32(bytes + 16),
+               readU32(bytes + 20)};
+}
+
+inline void writeEntry(unsigned char *bytes, const Entry &entry) {
+  writeU64(bytes, entry.offset);
+  writeU64(bytes + 8, entry.size);
+  writeU32(bytes + 16, entry.nameOffset);
+  writeU32(bytes + 20, entry.nameLength);
+}
+
+} // namespace PackFormat
+
+#endif // PACK_FORMAT_H
@@ -0,0 +1,102 @@
+#ifndef PARTICLE_SYSTEM_H
+#define PARTICLE_SYSTEM_H
+
+#include "render_snapshot.h"
+#include <SDL2/SDL.h>
+#include <vector>
+
+/**
+ * ParticleEmitter - Description of one kind of particle burst
+ *
+ * Plain data, meant for constexpr tables. Each range is sampled uniformly
+ * per particle; sizes and colors are interpolated over its lifetime.
+ */
+struct ParticleEmitter {
+  int count;                      // Particles per burst
+  float angle;                    // Launch direction, radians (0 = right)
+  float spread;                   // Full width of the launch cone, radians
+  float speedMin, speedMax;       // Pixels per second
+  float lifeMin, lifeMax;         // Seconds
+  float sizeStart, sizeEnd;       // Pixels
+  SDL_Color colorStart, colorEnd; // Tint, including alpha
+  float gravity;                  // Pixels per second squared, downwards
+  float drag;                     // Fraction of the speed lost per second
+};
+
+/**
+ * ParticleSystem - Short-lived visual particles in fixed-capacity pools
+ *
+ * Features:
+ * - One pool per emitter kind, sized once: emitting and updating never
+ *   allocate, and a full pool drops new particles instead of growing
+ * - Structure-of-arrays storage: update() runs branch-free loops over
+ *   plain float arrays that the compiler can vectorize; dead particles are
+ *   swapped out so the arrays stay dense
+ * - render() records one quad per particle, grouped into one batch per
+ *   texture; the snapshot draws each batch with a single
+ *   SDL_RenderGeometry call
+ *
+ * Purely visual: particles don't collide and aren't part of the rewind or
+ * replay state. Not thread-safe; use it from the simulation thread.
+ *
+ * Usage:
+ * ParticleSystem::Pool sparks = particles.addPool(SPARKS, texture, src, 256);
+ * particles.emit(sparks, x, y);
+ * particles.update(dt);
+ * particles.render(snapshot);
+ */
+class ParticleSystem {
+public:
+  using Pool = size_t;
+
+  /**
+   * Add a pool for one emitter kind (setup only: allocates the arrays)
+   * @param emitter Burst description, copied
+   * @param texture Non-owning; must outlive every snapshot. Pools without
+   *        a texture are simulated but not drawn.
+   * @param src Region of the texture every particle shows
+   * @param capacity Most particles alive in the pool at once
+   */
+  Pool addPool(const ParticleEmitter &emitter, SDL_Texture *texture,
+               const SDL_Rect &src, size_t capacity);
+
+  // Spawn a burst at (x, y) in the emitter's direction
+  void emit(Pool pool, float x, float y);
+  // Spawn a burst launched around another direction (radians)
+  void emit(Pool pool, float x, float y, float angle);
+
+  // Move, age and retire every particle
+  void update(float dt);
+
+  // Record every live particle
+  void render(RenderSnapshot &snapshot) const;
+
+  // Retire every particle, keeping the pools
+  void clear();
+
+  // Live particles over all pools
+  size_t size() const;
+
+private:
+  struct Particles {
+    ParticleEmitter emitter;
+    SDL_Texture *texture;
+    SDL_Rect src;
+    size_t count = 0; // Live particles; the first count entries
+
+    // One array per field, each sized to the pool's capacity
+    std::vector<float> x, y;
+    std::vector<float> velX, velY;
+    std::vector<float> age;     // 0 at birth, 1 at death
+    std::vector<float> ageRate; // 1 / lifetime
+  };
+
+  std::vector<Particles> pools;
+  std::vector<Pool> drawOrder; // Pools sharing a texture are adjacent
+  Uint32 randomState = 0x9E3779B9u;
+
+  // Uniform in [min, max]; a xorshift is plenty for visuals
+  float random(float min, float max);
+};
+
+#endif // PARTICLE_SYSTEM_H
@@ -38,8 +38,13 @@ public:
   std::shared_ptr<Sprite> getSprite() const { return sprite; }
   virtual PlatformType getPlatformType() const { return type; }
 
+  // TileAnimator slot of the tile's type, or -1 for a static tile
+  void setAnimationSlot(int slot) { animationSlot = slot; }
+  int getAnimationSlot() const { return animationSlot; }
+
 private:
   PlatformType type = PlatformType::LAND;
+  int animationSlot = -1;
   SDL_FRect bounds;
   std::shared_ptr<Texture> texture;
   std::shared_ptr<Sprite> sprite; // Optional sprite for rendering
@@ -1,18 +1,24 @@
 #ifndef PLAYER_H
 #define PLAYER_H
 
+#include "animation_clip.h"
 #include "audio_manager.h"
 #include "collideable.h"
 #include "config.h"
+#include "render_snapshot.h"
 #include "sprite.h"
+#include "state_stream.h"
 #include "texture.h"
 #include <SDL2/SDL.h>
+#include <array>
 #include <memory>
-#include <unordered_map>
-#include <vector>
 
 enum class Direction { LEFT, UP, RIGHT, DOWN };
 enum class MovementState { IDLE, MOVING, JUMPING, CROUCHING };
+constexpr size_t MOVEMENT_STATE_COUNT = 4;
+
+// One clip per MovementState, indexed by the state. Shared, never copied.
+using MovementClips = std::array<const AnimationClip *, MOVEMENT_STATE_COUNT>;
 
 class RectPlayer : public Collideable {
 public:
@@ -30,25 +36,28 @@ public:
   void setAudioManager(std::shared_ptr<AudioManager> audioMgr);
 
   // Animation
-  void setAnimation(const std::vector<SDL_Rect> &frames, float frameTime);
+  void setAnimation(const AnimationClip &clip);
   void animationHandle();
-  void renderAnimation(SDL_Renderer *renderer, float dt,
-                       bool boundingBox = false) const;
-  void SetAnimationMap(
-      std::unordered_map<MovementState, std::vector<SDL_Rect>> anims);
-  std::unordered_map<MovementState, std::vector<SDL_Rect>>
-  getAnimationMap() const;
+  void updateAnimation(float dt);
+  // Only the pointer is kept: the clips must outlive the player
+  void setAnimations(const MovementClips &clips);
+  const MovementClips &getAnimations() const;
+  // Clips of the stock player sprite sheet
+  static const MovementClips &defaultAnimations();
 
   // Core functionality
   void update(float dt);
   void handleMovement(float dt, bool moveLeft, bool moveRight, bool jump,
                       bool fastFall, bool dash, bool crouch);
-  void render(SDL_Renderer *renderer) const;
+  // Record the current frame, facing the last direction moved
+  void render(RenderSnapshot &snapshot, bool boundingBox = false) const;
 
   // Physics
   float getGravity() const;
   void setGravity(float g);
   void stopFalling();
+  // Area the player is kept inside (horizontally and from above)
+  void setWorldBounds(const SDL_FRect &bounds);
 
   // Jump system
   void resetJump();
@@ -85,12 +94,19 @@ public:
   void setPos(float x, float y) override;
   void onCollision(Collideable *other, float normalX, float normalY,
                    float penetration) override;
+  // Stop against a contact with the given normal (from the player's side)
+  void applyContact(float normalX, float normalY);
   bool isStatic() const override;
   ObjectType getType() const override;
   void init();
 
+  // Rewind: every field the simulation changes, including the animation
+  // position
+  void saveState(StateWriter &out) const;
+  void loadState(StateReader &in);
+
 private:
-  std::unordered_map<MovementState, std::vector<SDL_Rect>> animations;
+  const MovementClips *animations = &defaultAnimations();
   MovementState state;
   MovementState previousState;
   std::shared_ptr<Texture> texture;
@@ -102,6 +118,9 @@ private:
   float pos_x, pos_y;
   float vel_x, vel_y;
   float gravity;
+  SDL_FRect worldBounds = {
+      0.0f, 0.0f, static_cast<float>(DEFAULT_MAP_WIDTH * DEFAULT_TILE_WIDTH),
+      static_cast<float>(DEFAULT_MAP_HEIGHT * DEFAULT_TILE_HEIGHT)};
 
   bool onGround;
   bool isJumping;
@@ -0,0 +1,71 @@
+#ifndef RENDER_CACHE_H
+#define RENDER_CACHE_H
+
+#include <SDL2/SDL.h>
+#include <memory>
+
+/**
+ * RenderCache - Keeps static drawing in a render-target texture
+ *
+ * Features:
+ * - The first render() runs the draw callback into a texture; later calls
+ *   only copy that texture until invalidate() is called
+ * - Transparent caches (overlays) are cleared to alpha 0 and blended when
+ *   copied; opaque ones (whole frames) are copied as is
+ * - Falls back to drawing directly when the renderer has no render targets
+ *
+ * Call invalidate() when the content changes or the window is resized, and
+ * release() on SDL_RENDER_DEVICE_RESET (the texture itself is lost).
+ *
+ * Usage:
+ * RenderCache menu(renderer, 800, 600, true);
+ * menu.render([&]() { drawMenu(); }); // every frame
+ */
+class RenderCache {
+public:
+  /**
+   * @param width, height Size in render (logical) coordinates
+   * @param transparent Whether the content has see-through parts
+   */
+  RenderCache(SDL_Renderer *renderer, int width, int height,
+              bool transparent);
+
+  /**
+   * Copy the cached content to the current target at (0, 0), redrawing it
+   * with draw() first if it is invalid
+   */
+  template <typename Draw> void render(Draw &&draw) {
+    if (!valid) {
+      if (!beginRedraw()) {
+        draw(); // No render targets: draw straight through, every time
+        return;
+      }
+      draw();
+      endRedraw();
+    }
+    present();
+  }
+
+  void invalidate() { valid = false; }
+
+  // Destroy the texture; it is recreated on the next render()
+  void release();
+
+  bool isValid() const { return valid; }
+
+private:
+  SDL_Renderer *renderer;
+  int width;
+  int height;
+  bool transparent;
+  bool valid = false;
+
+  std::unique_ptr<SDL_Texture, void (*)(SDL_Texture *)> texture;
+  SDL_Texture *previousTarget = nullptr;
+
+  bool beginRedraw();
+  void endRedraw();
+  void present();
+};
+
+#endif // RENDER_CACHE_H
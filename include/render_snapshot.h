@@ -0,0 +1,83 @@
+#ifndef RENDER_SNAPSHOT_H
+#define RENDER_SNAPSHOT_H
+
+#include <SDL2/SDL.h>
+#include <cstdint>
+#include <vector>
+
+/**
+ * RenderSnapshot - Everything needed to draw one simulation state
+ *
+ * Features:
+ * - A flat list of sprite draws (texture, frame, position, flip, opacity)
+ *   in back-to-front order, copied out of the world by the simulation
+ * - Particle quads on top, batched by texture: one SDL_RenderGeometry call
+ *   per batch
+ * - Holds no pointers into the world itself, so the render thread can draw
+ *   it while the simulation moves on
+ * - The pause/win flags the frame was taken in, for the overlays
+ *
+ * Textures are referenced, not owned: they must outlive every snapshot
+ * (the game loads them all up front and frees them after both threads stop).
+ *
+ * Usage:
+ * snapshot.clear();
+ * map->render(snapshot);   // simulation thread
+ * snapshot.draw(renderer); // render thread
+ */
+struct RenderSnapshot {
+  struct SpriteDraw {
+    SDL_Texture *texture;
+    SDL_Rect src;
+    SDL_FRect dest;
+    SDL_RendererFlip flip;
+    Uint8 alpha;
+  };
+
+  struct ParticleQuad {
+    SDL_FRect dest;
+    SDL_Rect src;
+    SDL_Color color; // Tint and opacity
+  };
+
+  // A run of particles sharing one texture
+  struct ParticleBatch {
+    SDL_Texture *texture;
+    size_t first; // Into particles
+    size_t count;
+  };
+
+  std::vector<SpriteDraw> sprites;
+  std::vector<ParticleQuad> particles; // Drawn after the sprites
+  std::vector<ParticleBatch> particleBatches;
+  std::vector<SDL_FRect> outlines; // Debug bounding boxes, drawn on top
+
+  bool paused = false;
+  bool won = false;
+  std::uint64_t tick = 0; // Simulation tick the snapshot was taken after
+
+  // Empty the lists, keeping their capacity
+  void clear() {
+    sprites.clear();
+    particles.clear();
+    particleBatches.clear();
+    outlines.clear();
+  }
+
+  /**
+   * Draw every sprite, then the particles and the outlines (render thread
+   * only)
+   */
+  void draw(SDL_Renderer *renderer) const;
+
+private:
+  void drawParticles(SDL_Renderer *renderer) const;
+
+#if SDL_VERSION_ATLEAST(2, 0, 18)
+  // Render thread scratch for the particle geometry, reused between draws
+  mutable std::vector<SDL_Vertex> vertices;
+  mutable std::vector<int> indices;
+#endif
+};
+
+#endif // RENDER_SNAPSHOT_H
@@ -0,0 +1,74 @@
+#ifndef REPLAY_H
+#define REPLAY_H
+
+#include <SDL2/SDL.h>
+#include <string>
+#include <vector>
+
+/**
+ * Replay - Per-tick input and state hashes of one play session
+ *
+ * Features:
+ * - Two bytes of input per simulation tick: the InputAction bits the tick
+ *   ran with, plus pause and restart flags
+ * - One state hash per tick (player position, collected coins, coin and
+ *   arrow positions) so playback can tell exactly where it diverged
+ * - Saved with the tick rate and a hash of the map file, so a replay is
+ *   never played against a different world
+ * - Inputs are run-length encoded on disk: held keys cost a few bytes per
+ *   run, not per tick
+ *
+ * Usage:
+ * Replay replay(SIMULATION_TICK_RATE, Replay::hashResource(MAP_FILE_PATH));
+ * replay.record(inputBits, stateHash); // every tick
+ * replay.save("session.rpl");
+ */
+class Replay {
+public:
+  // Flags stored next to the InputAction bits
+  enum Flag : Uint16 {
+    PAUSE = 1u << 8,   // Pause toggled since the previous tick
+    RESTART = 1u << 9, // Game restarted since the previous tick
+  };
+  static constexpr Uint16 INPUT_MASK = 0xFF; // InputAction bits
+
+  static constexpr Uint32 HASH_SEED = 2166136261u; // FNV-1a offset basis
+
+  Replay() = default;
+  Replay(int tickRate, Uint32 mapHash);
+
+  // Append one tick
+  void record(Uint16 input, Uint32 stateHash);
+
+  size_t tickCount() const { return inputs.size(); }
+  Uint16 inputAt(size_t tick) const { return inputs[tick]; }
+  Uint32 hashAt(size_t tick) const { return hashes[tick]; }
+  int getTickRate() const { return tickRate; }
+  Uint32 getMapHash() const { return mapHash; }
+
+  /**
+   * Write the replay to a file
+   * @return false (and an error on stderr) if it can't be written
+   */
+  bool save(const std::string &path) const;
+
+  /**
+   * Replace this replay with one read from a file
+   * @return false (and an error on stderr) if it can't be read
+   */
+  bool load(const std::string &path);
+
+  // FNV-1a over bytes, continuing from a previous hash
+  static Uint32 hash(const void *data, size_t size, Uint32 hash = HASH_SEED);
+
+  // Hash of a resource's contents (through Vfs); 0 if it can't be read
+  static Uint32 hashResource(const std::string &path);
+
+private:
+  int tickRate = 0;
+  Uint32 mapHash = 0;
+  std::vector<Uint16> inputs;
+  std::vector<Uint32> hashes;
+};
+
+#endif // REPLAY_H
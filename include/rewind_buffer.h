@@ -0,0 +1,83 @@
+#ifndef REWIND_BUFFER_H
+#define REWIND_BUFFER_H
+
+#include <SDL2/SDL.h>
+#include <vector>
+
+/**
+ * RewindBuffer - The last few seconds of world state, delta compressed
+ *
+ * Features:
+ * - A keyframe every keyframeInterval ticks; the ticks in between are
+ *   stored as their XOR against that keyframe, run-length encoded. Little of
+ *   the world changes between nearby ticks, so a delta is mostly zero runs.
+ * - A fixed ring of frame buffers that keep their capacity: once the ring
+ *   has gone round, capturing a tick doesn't allocate
+ * - restore() rebuilds any tick in the window from its keyframe and one
+ *   delta; drop() discards the newest ticks, so restoring and dropping
+ *   walks backwards through time
+ *
+ * States are opaque bytes (see StateWriter). A state of a different size
+ * than its keyframe starts a new keyframe. When the ring is full the oldest
+ * keyframe is evicted together with its deltas, so between `ticks` and
+ * `ticks + keyframeInterval` ticks are kept.
+ *
+ * Usage:
+ * RewindBuffer history(REWIND_SECONDS * SIMULATION_TICK_RATE,
+ *                      REWIND_KEYFRAME_INTERVAL);
+ * history.push(state);               // every tick
+ * history.drop(1);
+ * if (history.restore(0, state)) ... // the tick before
+ */
+class RewindBuffer {
+public:
+  /**
+   * @param ticks Ticks that can always be restored once this many were
+   *              pushed
+   * @param keyframeInterval Ticks per keyframe (at least 1)
+   */
+  RewindBuffer(size_t ticks, size_t keyframeInterval);
+
+  // Append the newest tick, evicting the oldest ones if the ring is full
+  void push(const std::vector<Uint8> &state);
+
+  /**
+   * Rebuild a stored tick
+   * @param ticksBack 0 for the newest tick, 1 for the one before, ...
+   * @param state Receives the state; keeps its capacity
+   * @return false if that tick isn't stored
+   */
+  bool restore(size_t ticksBack, std::vector<Uint8> &state) const;
+
+  // Discard up to `ticks` of the newest ticks
+  void drop(size_t ticks);
+
+  void clear();
+
+  // Ticks currently stored
+  size_t size() const { return static_cast<size_t>(end - first); }
+
+  // Bytes held by the stored ticks (keyframes plus deltas)
+  size_t storedBytes() const;
+
+private:
+  struct Frame {
+    std::vector<Uint8> bytes; // Whole state (keyframe) or encoded delta
+    Uint64 keyframe = 0;      // Tick of the keyframe; itself for keyframes
+  };
+
+  std::vector<Frame> frames; // Ring indexed by tick % frames.size()
+  size_t keyframeInterval;
+  Uint64 first = 0; // Oldest stored tick
+  Uint64 end = 0;   // One past the newest stored tick
+
+  Frame &frameAt(Uint64 tick) { return frames[tick % frames.size()]; }
+  const Frame &frameAt(Uint64 tick) const {
+    return frames[tick % frames.size()];
+  }
+
+  // Remove the oldest keyframe and every delta against it
+  void evictOldest();
+};
+
+#endif // REWIND_BUFFER_H
@@ -0,0 +1,35 @@
+#ifndef SOUND_ID_H
+#define SOUND_ID_H
+
+#include <cstdint>
+
+/**
+ * Identifies a registered sound: the 32-bit FNV-1a hash of its name.
+ * Computed at compile time for named constants (see SoundId), so playing a
+ * sound never builds or hashes a string. AudioManager refuses to register
+ * a name whose hash is already taken by a different name.
+ */
+using SoundHandle = std::uint32_t;
+
+constexpr SoundHandle hashSoundName(const char *name) {
+  std::uint32_t hash = 2166136261u;
+  while (*name) {
+    hash ^= static_cast<std::uint8_t>(*name++);
+    hash *= 16777619u;
+  }
+  return hash;
+}
+
+/**
+ * Sound name paired with its precomputed handle
+ */
+struct SoundId {
+  const char *name;
+  SoundHandle handle;
+
+  constexpr SoundId(const char *name)
+      : name(name), handle(hashSoundName(name)) {}
+  constexpr operator SoundHandle() const { return handle; }
+};
+
+#endif // SOUND_ID_H
@@ -7,13 +7,15 @@
  *
  * Features:
  * - Position, size, and flip transformations
- * - Frame-based sprite sheet animation
+ * - Sprite sheet animation from shared, immutable AnimationClips
  * - Collision detection (both integer and float precision)
  * - Sub-pixel positioning with SDL_FRect
  */
 
+#include "animation_clip.h"
 #include "texture.h"
-#include <vector>
+
+struct RenderSnapshot;
 
 class Sprite {
 private:
@@ -34,13 +36,11 @@ private:
   // Visibility flag (may be unused in current implementation)
   bool visible{true};
 
-  // Animation system - frame-based sprite sheet animation
-  std::vector<SDL_Rect> frames; // Source rects for each frame
-  size_t currentFrame{0};       // Current frame index
-  float frameDuration{0.0f};    // Seconds per frame
-  float frameTimer{0.0f};       // Time accumulator
-  bool looping{true};           // Loop animation when it ends
-  bool playing{false};          // Animation playing state
+  // Animation system - position within a shared clip
+  const AnimationClip *clip{nullptr}; // Non-owning; nullptr = no animation
+  size_t currentFrame{0};             // Current frame index
+  float frameTimer{0.0f};             // Time accumulator
+  bool playing{false};                // Animation playing state
 
 public:
   /**
@@ -60,6 +60,15 @@ public:
   int render(SDL_Renderer *renderer,
              SDL_RendererFlip flip = SDL_FLIP_NONE) const;
 
+  /**
+   * Record the sprite into a render snapshot instead of drawing it now.
+   * Safe off the render thread: the renderer isn't touched.
+   * @param flip Optional flip mode override (as for render())
+   * @param alpha Opacity the draw is made with
+   */
+  void render(RenderSnapshot &snapshot, SDL_RendererFlip flip = SDL_FLIP_NONE,
+              Uint8 alpha = SDL_ALPHA_OPAQUE) const;
+
   // Source rectangle management
   void setSrcRect(const SDL_Rect &rect);
   SDL_Rect getSrcRect() const;
@@ -79,12 +88,28 @@ public:
   SDL_Point size() const;
   void scale(float factor_w, float factor_h);
 
+  /**
+   * Play a clip from its first frame. Only the pointer is kept: the clip
+   * must outlive the sprite (or the next setClip()). Never allocates.
+   * @param animation Clip to play, or nullptr to stop animating
+   */
+  void setClip(const AnimationClip *animation);
+  const AnimationClip *getClip() const;
+
   // Animation control
-  void setFrames(const std::vector<SDL_Rect> &f, float secondsPerFrame,
-                 bool loop = true);
   void play();
   void stop();
 
+  // Position within the current animation, for saving simulation state
+  struct Playback {
+    Uint32 frame;
+    float timer;
+    bool playing;
+  };
+  Playback getPlayback() const;
+  // Restore a saved position; the clip itself must already be set
+  void setPlayback(const Playback &playback);
+
   /**
    * Update animation state.
    * @param dt Delta time in seconds since last update
@@ -0,0 +1,66 @@
+#ifndef SPSC_QUEUE_H
+#define SPSC_QUEUE_H
+
+#include <array>
+#include <atomic>
+#include <cstddef>
+
+/**
+ * SpscQueue - Bounded lock-free single-producer/single-consumer ring buffer
+ *
+ * Features:
+ * - Fixed capacity, storage is inline: push() and pop() never allocate
+ * - Never blocks: push() fails when full, pop() fails when empty
+ * - Exactly one thread may push and exactly one (possibly other) thread may
+ *   pop at any time
+ *
+ * Usage:
+ * SpscQueue<Command, 64> queue;
+ * queue.push(cmd);           // producer
+ * while (queue.pop(cmd)) {}  // consumer
+ */
+template <typename T, size_t Capacity> class SpscQueue {
+  static_assert(Capacity >= 2 && (Capacity & (Capacity - 1)) == 0,
+                "SpscQueue capacity must be a power of two");
+
+public:
+  /**
+   * Append an item (producer thread only)
+   * @return false if the queue is full; the item is dropped
+   */
+  bool push(const T &item) {
+    const size_t tail = tailIndex.load(std::memory_order_relaxed);
+    if (tail - headIndex.load(std::memory_order_acquire) == Capacity)
+      return false;
+    slots[tail & (Capacity - 1)] = item;
+    tailIndex.store(tail + 1, std::memory_order_release);
+    return true;
+  }
+
+  /**
+   * Remove the oldest item (consumer thread only)
+   * @return false if the queue is empty
+   */
+  bool pop(T &item) {
+    const size_t head = headIndex.load(std::memory_order_relaxed);
+    if (head == tailIndex.load(std::memory_order_acquire))
+      return false;
+    item = slots[head & (Capacity - 1)];
+    headIndex.store(head + 1, std::memory_order_release);
+    return true;
+  }
+
+  bool empty() const {
+    return headIndex.load(std::memory_order_acquire) ==
+           tailIndex.load(std::memory_order_acquire);
+  }
+
+private:
+  std::array<T, Capacity> slots{};
+
+  // Producer and consumer indices live on separate cache lines
+  alignas(64) std::atomic<size_t> headIndex{0};
+  alignas(64) std::atomic<size_t> tailIndex{0};
+};
+
+#endif // SPSC_QUEUE_H
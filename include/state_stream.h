@@ -0,0 +1,92 @@
+#ifndef STATE_STREAM_H
+#define STATE_STREAM_H
+
+#include <SDL2/SDL.h>
+#include <cstring>
+#include <type_traits>
+#include <vector>
+
+/**
+ * StateWriter / StateReader - Packed byte form of simulation state
+ *
+ * Features:
+ * - Values are copied field by field with no padding in between, so equal
+ *   states always give equal bytes (RewindBuffer's deltas rely on that)
+ * - The writer appends to a caller-owned buffer, which keeps its capacity
+ *   from one capture to the next
+ * - Reading past the end leaves the value untouched and marks the reader
+ *   as failed instead of throwing
+ *
+ * Only trivially copyable values (and arrays of them) can be written. Read
+ * them back in the order they were written.
+ *
+ * Usage:
+ * state.clear();
+ * StateWriter out(state);
+ * out.write(pos_x);
+ * StateReader in(state);
+ * in.read(pos_x);
+ */
+class StateWriter {
+public:
+  explicit StateWriter(std::vector<Uint8> &bytes) : bytes(bytes) {}
+
+  template <typename T> void write(const T &value) {
+    static_assert(std::is_trivially_copyable<T>::value,
+                  "Only plain values can be written");
+    const size_t offset = bytes.size();
+    bytes.resize(offset + sizeof(T));
+    std::memcpy(bytes.data() + offset, &value, sizeof(T));
+  }
+
+  // An array of values as one block
+  template <typename T> void write(const T *values, size_t count) {
+    static_assert(std::is_trivially_copyable<T>::value,
+                  "Only plain values can be written");
+    const size_t offset = bytes.size();
+    bytes.resize(offset + count * sizeof(T));
+    if (count > 0)
+      std::memcpy(bytes.data() + offset, values, count * sizeof(T));
+  }
+
+private:
+  std::vector<Uint8> &bytes;
+};
+
+class StateReader {
+public:
+  explicit StateReader(const std::vector<Uint8> &bytes) : bytes(bytes) {}
+
+  template <typename T> void read(T &value) {
+    static_assert(std::is_trivially_copyable<T>::value,
+                  "Only plain values can be read");
+    if (sizeof(T) > bytes.size() - offset) {
+      failed = true;
+      return;
+    }
+    std::memcpy(&value, bytes.data() + offset, sizeof(T));
+    offset += sizeof(T);
+  }
+
+  template <typename T> void read(T *values, size_t count) {
+    static_assert(std::is_trivially_copyable<T>::value,
+                  "Only plain values can be read");
+    if (count * sizeof(T) > bytes.size() - offset) {
+      failed = true;
+      return;
+    }
+    if (count > 0)
+      std::memcpy(values, bytes.data() + offset, count * sizeof(T));
+    offset += count * sizeof(T);
+  }
+
+  // Every read so far was in bounds
+  bool ok() const { return !failed; }
+
+private:
+  const std::vector<Uint8> &bytes;
+  size_t offset = 0;
+  bool failed = false;
+};
+
+#endif // STATE_STREAM_H
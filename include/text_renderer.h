@@ -0,0 +1,107 @@
+#ifndef TEXT_RENDERER_H
+#define TEXT_RENDERER_H
+
+#include <SDL2/SDL.h>
+#include <SDL2/SDL_ttf.h>
+#include <array>
+#include <memory>
+#include <vector>
+
+/**
+ * TextRenderer - Draws text from a glyph atlas in batched quads
+ *
+ * Features:
+ * - Printable ASCII is rasterized once, at construction, into a single
+ *   atlas texture together with each glyph's advance and the font's
+ *   kerning pairs
+ * - draw() only lays out quads; flush() submits every quad queued since the
+ *   last flush in one SDL_RenderGeometry call. No surfaces or textures are
+ *   created per frame, and the batch buffers are reused.
+ * - Per-string color and scale; '\n' starts a new line
+ *
+ * The font is not needed after construction. Characters outside printable
+ * ASCII are drawn as '?'.
+ *
+ * Usage:
+ * TextRenderer text(renderer, font);
+ * SDL_Rect bounds = text.draw("Score: 10", 8, 8, white);
+ * text.flush(); // before drawing anything that must appear on top
+ */
+class TextRenderer {
+public:
+  /**
+   * Build the atlas
+   * @param renderer Renderer the atlas texture is created with
+   * @param font Font to rasterize; only used during construction
+   * @throws std::runtime_error if the atlas can't be created
+   */
+  TextRenderer(SDL_Renderer *renderer, TTF_Font *font);
+
+  /**
+   * Size of a string as draw() would lay it out
+   */
+  SDL_Point measure(const char *text, float scale = 1.0f) const;
+
+  /**
+   * Queue a string; it appears on the next flush()
+   * @param x, y Top-left corner in render coordinates
+   * @return Bounds of the laid out text
+   */
+  SDL_Rect draw(const char *text, int x, int y, SDL_Color color,
+                float scale = 1.0f);
+
+  // Queue a string horizontally centered on centerX
+  SDL_Rect drawCentered(const char *text, int centerX, int y, SDL_Color color,
+                        float scale = 1.0f);
+
+  /**
+   * Render every queued quad, then clear the batch
+   */
+  void flush();
+
+  int getLineHeight() const { return lineHeight; }
+
+  TextRenderer(const TextRenderer &) = delete;
+  TextRenderer &operator=(const TextRenderer &) = delete;
+
+private:
+  static constexpr int FIRST_GLYPH = 32; // ' '
+  static constexpr int LAST_GLYPH = 126; // '~'
+  static constexpr int GLYPH_COUNT = LAST_GLYPH - FIRST_GLYPH + 1;
+
+  struct Glyph {
+    SDL_Rect source; // Cell in the atlas
+    int advance;     // Pen movement in pixels
+  };
+
+  struct Quad {
+    SDL_FRect target;
+    SDL_Rect source;
+    SDL_Color color;
+  };
+
+  SDL_Renderer *renderer;
+  std::unique_ptr<SDL_Texture, void (*)(SDL_Texture *)> atlas;
+  int atlasWidth = 0;
+  int atlasHeight = 0;
+  int lineHeight = 0; // Distance between baselines
+  int glyphHeight = 0;
+
+  std::array<Glyph, GLYPH_COUNT> glyphs{};
+  // Kerning adjustment for [previous][current] glyph
+  std::vector<short> kerning;
+
+  // Batch, reused across frames
+  std::vector<Quad> quads;
+  std::vector<SDL_Vertex> vertices;
+  std::vector<int> indices;
+
+  static int glyphIndex(char c);
+  int kerningFor(int previous, int current) const;
+
+  // Walk the layout of a string; visit(glyph, x, y) for each glyph
+  template <typename Visit>
+  SDL_Point layout(const char *text, float scale, Visit visit) const;
+};
+
+#endif // TEXT_RENDERER_H
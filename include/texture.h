@@ -27,6 +27,9 @@ private:
   // Smart pointer with custom deleter for automatic SDL_Texture cleanup
   std::unique_ptr<SDL_Texture, void (*)(SDL_Texture *)> texture;
 
+  // Create the GPU texture from a decoded surface
+  void upload(SDL_Renderer *renderer, SDL_Surface *surface, const char *name);
+
 public:
   /**
    * Load texture from image file.
@@ -36,6 +39,16 @@ public:
    */
   Texture(SDL_Renderer *renderer, const char *filePath);
 
+  /**
+   * Upload an already decoded surface (e.g. from AssetLoader).
+   * @param renderer SDL renderer to create texture with (must be non-null)
+   * @param surface Decoded image; not freed by this call (must be non-null)
+   * @param name Name used in error messages
+   * @throws std::runtime_error if the upload fails or parameters are invalid
+   */
+  Texture(SDL_Renderer *renderer, SDL_Surface *surface,
+          const char *name = "<surface>");
+
   /**
    * Get raw SDL_Texture pointer for rendering operations.
    * @return Non-owning pointer to SDL_Texture, or nullptr if invalid
@@ -0,0 +1,94 @@
+#ifndef TEXTURE_CACHE_H
+#define TEXTURE_CACHE_H
+
+#include "texture.h"
+#include <SDL2/SDL.h>
+#include <cstddef>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <unordered_map>
+
+/**
+ * TextureCache - Shares one Texture per image file
+ *
+ * Features:
+ * - Paths are resource paths (see Vfs) and are normalized, so "a/../b.png"
+ *   and "b.png" resolve to the same texture
+ * - The cache only holds weak references: a texture is destroyed as soon as
+ *   its last user releases it, and is loaded again on the next request
+ * - Tracks how many users each texture has and the GPU bytes resident
+ *
+ * Textures handed out stay valid even if the cache itself is destroyed
+ * first. Loading must happen on the renderer's thread; releasing may happen
+ * on any thread.
+ *
+ * Usage:
+ * TextureCache cache(renderer);
+ * std::shared_ptr<Texture> tiles = cache.load("tiles.png");
+ */
+class TextureCache {
+public:
+  /**
+   * @param renderer Renderer textures are created with (must outlive every
+   *                 texture handed out)
+   */
+  explicit TextureCache(SDL_Renderer *renderer);
+
+  /**
+   * Get the shared texture for an image, loading it on first use
+   * @param filePath Path to image file (PNG, JPG, etc.)
+   * @return Shared texture; never null
+   * @throws std::runtime_error if loading fails (see Texture)
+   */
+  std::shared_ptr<Texture> load(const std::string &filePath);
+
+  /**
+   * Same as load(), but uploads an image already decoded off-thread instead
+   * of reading the file. The surface is unused if the texture is cached.
+   * @param decoded Decoded image for filePath; may be null to decode here
+   */
+  std::shared_ptr<Texture> load(const std::string &filePath,
+                                SDL_Surface *decoded);
+
+  // Whether a live texture exists for the path (no decode needed)
+  bool contains(const std::string &filePath) const;
+
+  /**
+   * Number of live users of the texture for a path (0 if not resident)
+   */
+  long getUseCount(const std::string &filePath) const;
+
+  // Number of textures currently alive
+  size_t getTextureCount() const;
+
+  // Estimated texture memory currently alive, in bytes
+  size_t getResidentBytes() const;
+
+  /**
+   * Resolve a path to the key textures are cached under
+   */
+  static std::string canonicalPath(const std::string &filePath);
+
+  TextureCache(const TextureCache &) = delete;
+  TextureCache &operator=(const TextureCache &) = delete;
+
+private:
+  struct Entry {
+    std::weak_ptr<Texture> texture;
+    size_t bytes = 0;
+  };
+
+  // Shared with the textures' deleters so releasing a texture can update
+  // the bookkeeping even after the cache is gone
+  struct State {
+    std::mutex mutex;
+    std::unordered_map<std::string, Entry> entries;
+    size_t residentBytes = 0;
+  };
+
+  SDL_Renderer *renderer;
+  std::shared_ptr<State> state;
+};
+
+#endif // TEXTURE_CACHE_H
@@ -0,0 +1,64 @@
+#ifndef TILE_ANIMATOR_H
+#define TILE_ANIMATOR_H
+
+#include "tmx_parser.h"
+#include <SDL2/SDL.h>
+#include <vector>
+
+/**
+ * TileAnimator - Tiled tile animations driven by one global clock
+ *
+ * Features:
+ * - Every animated tile type (GID) gets a slot when the map loads; tiles
+ *   of that type only store the slot
+ * - update() resolves the current frame of each slot once, so the cost is
+ *   per tile type, not per tile: a thousand water tiles share one lookup
+ * - All tiles of a type show the same frame, as in Tiled
+ *
+ * slotOf() only reads data fixed by build(), so tiles can be created on
+ * worker threads while the animator is not being rebuilt.
+ *
+ * Usage:
+ * animator.build(tilesets);
+ * tile->setAnimationSlot(animator.slotOf(gid));
+ * animator.update(dt); // once per tick
+ * sprite->setSrcRect(animator.frame(tile->getAnimationSlot()));
+ */
+class TileAnimator {
+public:
+  // Collect the animated tile types of the tilesets and restart the clock
+  void build(const std::vector<TMXParser::TilesetInfo> &tilesets);
+  void clear();
+
+  // Slot of an animated GID, or -1 if the tile type is static
+  int slotOf(int gid) const;
+
+  /**
+   * Advance the clock and resolve the frame of every slot
+   * @param dt Seconds since the last update
+   */
+  void update(float dt);
+
+  // Source rect of a slot as of the last update
+  const SDL_Rect &frame(int slot) const {
+    return current[static_cast<size_t>(slot)];
+  }
+
+  size_t size() const { return animations.size(); }
+
+private:
+  struct Animation {
+    int gid;
+    size_t firstFrame; // Into frameRects / frameEnds
+    size_t frameCount;
+    Uint32 length; // Milliseconds for the whole cycle
+  };
+
+  std::vector<Animation> animations; // Sorted by GID; index = slot
+  std::vector<SDL_Rect> frameRects;
+  std::vector<Uint32> frameEnds; // Time each frame ends, from cycle start
+  std::vector<SDL_Rect> current; // Per slot
+  double clockMs = 0.0;
+};
+
+#endif // TILE_ANIMATOR_H
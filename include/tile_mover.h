@@ -0,0 +1,45 @@
+#ifndef TILE_MOVER_H
+#define TILE_MOVER_H
+
+#include "map.h"
+#include <SDL2/SDL.h>
+
+/**
+ * TileMover - Moves a box through the tile map one axis at a time
+ *
+ * Features:
+ * - X first, then Y: each axis only scans the tile columns (or rows) its
+ *   leading edge crosses, so the cost grows with the distance moved, not
+ *   with the number of tiles nearby
+ * - Stops flush against the first solid tile (see Map::isSolid) and
+ *   reports which sides touched, instead of pushing out of overlaps
+ *   afterwards: no snagging on the seams between tiles, and the outcome
+ *   doesn't depend on the order tiles are visited in
+ *
+ * The box should not overlap solid tiles when the move starts; tiles it
+ * already overlaps are ignored rather than pushed out of.
+ *
+ * Usage:
+ * SDL_FRect box = player->getCollisionBounds();
+ * Uint8 contacts = TileMover::move(*map, box, dx, dy);
+ * player->setGrounded(contacts & TileMover::GROUND);
+ */
+class TileMover {
+public:
+  // Sides that touched a solid tile during a move
+  enum Contact : Uint8 {
+    NONE = 0,
+    GROUND = 1 << 0,  // Bottom, moving down
+    WALL = 1 << 1,    // Left or right
+    CEILING = 1 << 2, // Top, moving up
+  };
+
+  /**
+   * Move a box by (dx, dy), stopping at solid tiles
+   * @param box Moved in place
+   * @return Contact flags
+   */
+  static Uint8 move(const Map &map, SDL_FRect &box, float dx, float dy);
+};
+
+#endif // TILE_MOVER_H
@@ -5,11 +5,6 @@
 #include <string>
 #include <vector>
 
-namespace tinyxml2 {
-class XMLDocument;
-class XMLElement;
-} // namespace tinyxml2
-
 class TMXParser {
 public:
   struct MapInfo {
@@ -19,6 +14,19 @@ public:
     int tileHeight;
     std::string orientation;
     std::string renderOrder;
+    bool infinite; // Layer data is stored in <chunk> elements
+  };
+
+  // One frame of a Tiled tile animation
+  struct AnimationFrame {
+    int tileId;   // Local tile id within the same tileset
+    int duration; // Milliseconds
+  };
+
+  // <tile><animation> of a tileset: the tile shows these frames in turn
+  struct TileAnimation {
+    int tileId; // Local id of the animated tile
+    std::vector<AnimationFrame> frames;
   };
 
   struct TilesetInfo {
@@ -30,7 +38,19 @@ public:
     int rows;
     int imageWidth;
     int imageHeight;
-    std::string imagePath;
+    std::string imagePath; // Resolved relative to the TMX file, as Tiled does
+    std::vector<TileAnimation> animations;
+  };
+
+  // One <chunk> of an infinite map layer. Only indexed while loading: the
+  // GIDs are decoded on demand from dataOffset (see TMXReader::readChunkData).
+  struct Chunk {
+    int x; // Position and size in tiles
+    int y;
+    int width;
+    int height;
+    size_t dataOffset; // Byte offset of the chunk's CSV text in the file
+    int tileCount;     // Number of non-empty tiles
   };
 
   struct Layer {
@@ -40,7 +60,8 @@ public:
     int height;
     bool visible;
     float opacity;
-    std::vector<int> data;
+    std::vector<int> data;     // Finite maps
+    std::vector<Chunk> chunks; // Infinite maps
   };
 
   // Constructor
@@ -49,19 +70,27 @@ public:
   // Destructor
   ~TMXParser();
 
-  // Load and parse the TMX file
+  // Load and parse the TMX file. The file is streamed (see TMXReader); only
+  // the decoded map, tileset and layer data are kept.
   void loadFile();
 
   // Get parsed information
   MapInfo getMapInfo() const;
   std::vector<TilesetInfo> getTilesetInfo() const;
-  std::vector<Layer> getLayersInfo() const;
+  const std::vector<Layer> &getLayersInfo() const;
+
+  // Drop decoded layer data once it has been turned into game objects
+  void releaseLayerData();
+
+  const std::string &getFilePath() const { return tmxFilePath; }
 
 private:
   std::string tmxFilePath;
-  std::unique_ptr<tinyxml2::XMLDocument> doc;
-  tinyxml2::XMLElement *mapElement;
+  bool loaded = false;
+
+  MapInfo mapInfo{};
+  std::vector<TilesetInfo> tilesets;
+  std::vector<Layer> layers;
 
-  // Helper to trim whitespace
-  std::string trim(const std::string &str) const;
+  void requireLoaded() const;
 };
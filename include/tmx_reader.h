@@ -0,0 +1,112 @@
+#ifndef TMX_READER_H
+#define TMX_READER_H
+
+#include "tmx_parser.h"
+#include <SDL2/SDL.h>
+#include <string>
+#include <vector>
+
+/**
+ * TMXReader - Streaming (pull-parser) reader for Tiled TMX files
+ *
+ * Features:
+ * - Reads the file in fixed-size blocks through SDL_RWops; no DOM and no
+ *   full copy of the file text is ever held in memory
+ * - Emits map, tileset and layer events to a Handler in file order
+ * - CSV <data> is decoded straight into the buffer the Handler provides
+ *
+ * Only the parts of TMX the game uses are interpreted: the <map> element,
+ * embedded <tileset>/<image>, tile <animation>s and top-level
+ * <layer>/<data encoding="csv">, including the <chunk> elements of infinite
+ * maps. Everything else is skipped.
+ *
+ * Usage:
+ * struct MyHandler : TMXReader::Handler { ... };
+ * MyHandler handler;
+ * TMXReader::readFile("map.tmx", handler);
+ */
+class TMXReader {
+public:
+  /**
+   * Receives parse events. Default implementations ignore the event.
+   */
+  class Handler {
+  public:
+    virtual ~Handler() = default;
+
+    /**
+     * Called once after the <map> start tag has been read
+     */
+    virtual void onMap(const TMXParser::MapInfo & /*info*/) {}
+
+    /**
+     * Called when a <tileset> element (including its <image>) is complete
+     */
+    virtual void onTileset(const TMXParser::TilesetInfo & /*info*/) {}
+
+    /**
+     * Called after a <layer> start tag. Layer data is not filled in yet.
+     * @param layer Layer attributes (id, name, size, visibility, opacity)
+     * @return Buffer the layer's GIDs are decoded into, or nullptr to skip
+     *         the data
+     */
+    virtual std::vector<int> *
+    onLayerBegin(const TMXParser::Layer & /*layer*/) {
+      return nullptr;
+    }
+
+    /**
+     * Called for each <chunk> of an infinite map layer
+     * @param layer Owning layer's attributes
+     * @param chunk Chunk position/size and the byte offset of its data
+     * @return Buffer the chunk's GIDs are decoded into, or nullptr to only
+     *         index the chunk
+     */
+    virtual std::vector<int> *
+    onChunkBegin(const TMXParser::Layer & /*layer*/,
+                 const TMXParser::Chunk & /*chunk*/) {
+      return nullptr;
+    }
+
+    /**
+     * Called when the </chunk> end tag has been read
+     */
+    virtual void onChunkEnd(const TMXParser::Layer & /*layer*/,
+                            const TMXParser::Chunk & /*chunk*/) {}
+
+    /**
+     * Called when the </layer> end tag has been read
+     */
+    virtual void onLayerEnd(const TMXParser::Layer & /*layer*/) {}
+  };
+
+  /**
+   * Stream a TMX document from an SDL_RWops source
+   * @param source Readable stream positioned at the document start (not
+   *               closed by this call)
+   * @param handler Event receiver
+   * @param sourceName Name used in error messages
+   * @throws std::runtime_error on malformed input or unsupported encoding
+   */
+  static void read(SDL_RWops *source, Handler &handler,
+                   const std::string &sourceName = "<stream>");
+
+  /**
+   * Decode the CSV GIDs of a single chunk
+   * @param source Seekable stream over the same document that was indexed
+   * @param dataOffset Chunk::dataOffset recorded while reading
+   * @param out Receives the chunk's GIDs (appended)
+   * @throws std::runtime_error if the stream can't be positioned
+   */
+  static void readChunkData(SDL_RWops *source, size_t dataOffset,
+                            std::vector<int> &out,
+                            const std::string &sourceName = "<stream>");
+
+  /**
+   * Stream a TMX document from a resource file (see Vfs)
+   * @throws std::runtime_error if the file can't be opened or parsed
+   */
+  static void readFile(const std::string &filePath, Handler &handler);
+};
+
+#endif // TMX_READER_H
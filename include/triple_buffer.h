@@ -0,0 +1,70 @@
+#ifndef TRIPLE_BUFFER_H
+#define TRIPLE_BUFFER_H
+
+#include <array>
+#include <atomic>
+#include <cstdint>
+
+/**
+ * TripleBuffer - Lock-free hand-off of whole values from one thread to another
+ *
+ * Features:
+ * - Three slots: the writer fills back(), the reader holds front(), and the
+ *   third sits in between holding the latest published value
+ * - Neither side ever waits: publish() and update() are a single atomic
+ *   exchange each
+ * - The reader always gets the newest complete value; older ones it never
+ *   looked at are overwritten, not queued
+ * - Slots are reused, so values that own buffers (vectors) stop allocating
+ *   once every slot has grown to its working size
+ *
+ * Exactly one thread may write and exactly one (other) thread may read.
+ *
+ * Usage:
+ * TripleBuffer<Frame> frames;
+ * fill(frames.back()); frames.publish();         // writer
+ * if (frames.update()) show(frames.front());     // reader
+ */
+template <typename T> class TripleBuffer {
+public:
+  // Slot being written (writer thread only)
+  T &back() { return slots[backIndex]; }
+
+  /**
+   * Make back() the latest value and start writing into a free slot
+   * (writer thread only)
+   */
+  void publish() {
+    const std::uint8_t previous =
+        middle.exchange(backIndex | FRESH, std::memory_order_acq_rel);
+    backIndex = previous & INDEX_MASK;
+  }
+
+  /**
+   * Take the latest published value, if there is a newer one than front()
+   * (reader thread only)
+   * @return true if front() changed
+   */
+  bool update() {
+    if (!(middle.load(std::memory_order_relaxed) & FRESH))
+      return false;
+    const std::uint8_t latest =
+        middle.exchange(frontIndex, std::memory_order_acq_rel);
+    frontIndex = latest & INDEX_MASK;
+    return true;
+  }
+
+  // Slot being read (reader thread only); stable until the next update()
+  const T &front() const { return slots[frontIndex]; }
+
+private:
+  static constexpr std::uint8_t INDEX_MASK = 0x3;
+  static constexpr std::uint8_t FRESH = 0x4; // Middle not yet taken
+
+  std::array<T, 3> slots{};
+  alignas(64) std::uint8_t backIndex = 0;
+  alignas(64) std::atomic<std::uint8_t> middle{1};
+  alignas(64) std::uint8_t frontIndex = 2;
+};
+
+#endif // TRIPLE_BUFFER_H
@@ -0,0 +1,102 @@
+#ifndef VFS_H
+#define VFS_H
+
+#include <SDL2/SDL.h>
+#include <cstddef>
+#include <string>
+#include <unordered_map>
+
+/**
+ * Vfs - Read-only virtual filesystem over the resource pack
+ *
+ * Features:
+ * - Memory-maps a pack built by tools/pack_resources (see pack_format.h):
+ *   opening a file is a table lookup, and reads come straight from the
+ *   mapping with no copy and no per-file open/stat
+ * - Falls back to a loose directory for files missing from the pack, so
+ *   new assets can be tried without repacking. Packed files always win:
+ *   editing a loose copy of one has no effect until the pack is rebuilt
+ *   (or removed), which keeps opening a packed file free of any stat
+ * - Paths are relative to the resource root; "a/../b.png", "./b.png" and
+ *   the legacy "../resources/b.png" all name "b.png"
+ *
+ * Data returned by open()/find() stays valid while the Vfs is mounted, so
+ * fonts and music streaming from it must be closed first. Lookups are
+ * thread-safe once mounting is done.
+ *
+ * Usage:
+ * Vfs &vfs = Vfs::resources();
+ * vfs.mountDefault();
+ * SDL_Surface *image = IMG_Load_RW(vfs.open("monkey.png"), 1);
+ */
+class Vfs {
+public:
+  Vfs() = default;
+  ~Vfs();
+  Vfs(const Vfs &) = delete;
+  Vfs &operator=(const Vfs &) = delete;
+
+  // The game's resource root
+  static Vfs &resources();
+
+  /**
+   * Map a pack file, replacing any pack mounted before
+   * @return false if it is missing or not a valid pack
+   */
+  bool mountPack(const std::string &packPath);
+
+  // Serve files missing from the pack from a directory
+  void mountDirectory(const std::string &directoryPath);
+
+  /**
+   * Mount RESOURCE_PACK_NAME and RESOURCE_DIR_NAME found next to the
+   * executable, else in the working directory or its parent
+   * @return false if neither was found
+   */
+  bool mountDefault();
+
+  void unmount();
+
+  bool exists(const std::string &path) const;
+
+  /**
+   * Open a file for reading: a memory stream over the mapping for packed
+   * files, a file stream for loose ones
+   * @return Stream to close with SDL_RWclose (or a loader's freesrc), or
+   *         nullptr with SDL_GetError() set
+   */
+  SDL_RWops *open(const std::string &path) const;
+
+  /**
+   * Contents of a packed file, in place
+   * @return nullptr if the file is not in the pack
+   */
+  const void *find(const std::string &path, size_t &size) const;
+
+  // Canonical name of a path relative to the resource root
+  static std::string normalize(const std::string &path);
+
+  size_t getPackedFileCount() const { return entries.size(); }
+
+private:
+  struct Region {
+    const unsigned char *data;
+    size_t size;
+  };
+
+  // Mapping of the pack
+  const unsigned char *mapping = nullptr;
+  size_t mappingSize = 0;
+#ifdef _WIN32
+  void *fileHandle = nullptr;
+  void *mappingHandle = nullptr;
+#endif
+
+  std::unordered_map<std::string, Region> entries;
+  std::string directory; // Loose files; empty if none
+
+  bool mapFile(const std::string &packPath);
+  void unmapFile();
+};
+
+#endif // VFS_H
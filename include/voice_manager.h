@@ -0,0 +1,66 @@
+#ifndef VOICE_MANAGER_H
+#define VOICE_MANAGER_H
+
+#include "config.h"
+#include "sound_id.h"
+#include <cstdint>
+#include <unordered_map>
+#include <vector>
+
+/**
+ * VoiceManager - Decides which mixer voice (channel) a new sound plays on
+ *
+ * Features:
+ * - A fixed number of voices, so mixing cost is bounded however many
+ *   sounds gameplay requests
+ * - Per-sound priority and maximum number of simultaneous instances
+ * - When a sound is at its instance cap, its own oldest instance is
+ *   restarted; when every voice is busy, the oldest voice of the lowest
+ *   priority not above the new sound's is stolen
+ *
+ * Pure bookkeeping: the caller starts/stops playback and reports voices
+ * that finished on their own.
+ */
+class VoiceManager {
+public:
+  struct SoundParams {
+    int priority = 0; // Higher wins when voices are scarce
+    int maxInstances = AUDIO_DEFAULT_MAX_INSTANCES;
+  };
+
+  explicit VoiceManager(int voiceCount = AUDIO_VOICE_COUNT);
+
+  void setParams(SoundHandle sound, const SoundParams &params);
+  SoundParams getParams(SoundHandle sound) const;
+
+  /**
+   * Claim a voice for a new instance of a sound
+   * @return Voice index to (re)start the sound on, or -1 if it should be
+   *         dropped. The voice may still be playing something else, which
+   *         the caller must stop.
+   */
+  int allocate(SoundHandle sound);
+
+  // Mark a voice as free (finished or halted)
+  void release(int voice);
+
+  bool isActive(int voice) const;
+  int getVoiceCount() const { return static_cast<int>(voices.size()); }
+  int getActiveCount() const;
+
+private:
+  struct Voice {
+    bool active = false;
+    SoundHandle sound = 0;
+    int priority = 0;
+    std::uint64_t startOrder = 0; // Lower is older
+  };
+
+  std::vector<Voice> voices;
+  std::unordered_map<SoundHandle, SoundParams> params;
+  std::uint64_t nextStartOrder = 1;
+
+  int claim(int voice, SoundHandle sound, int priority);
+};
+
+#endif // VOICE_MANAGER_H
@@ -0,0 +1,147 @@
+#include "../include/asset_loader.h"
+#include "../include/audio_manager.h"
+#include "../include/vfs.h"
+#include <SDL2/SDL_image.h>
+#include <stdexcept>
+
+namespace {
+
+// Block on one pending result and remove it from the table
+template <typename T>
+T take(std::unordered_map<std::string, std::future<T>> &pending,
+       const std::string &key, const char *kind) {
+  auto it = pending.find(key);
+  if (it == pending.end()) {
+    throw std::runtime_error(std::string(kind) + " was never queued: " + key);
+  }
+  std::future<T> result = std::move(it->second);
+  pending.erase(it);
+  return result.get(); // Rethrows the decode error, if any
+}
+
+// Wait for every result in a table
+template <typename T>
+void waitAll(const std::unordered_map<std::string, std::future<T>> &pending) {
+  for (const auto &entry : pending) {
+    entry.second.wait();
+  }
+}
+
+// Free every result nobody collected
+template <typename T, typename Free>
+void freeAll(std::unordered_map<std::string, std::future<T>> &pending,
+             Free free) {
+  for (auto &entry : pending) {
+    try {
+      if (T value = entry.second.get())
+        free(value);
+    } catch (const std::exception &) {
+      // Failed decodes own nothing
+    }
+  }
+  pending.clear();
+}
+
+} // namespace
+
+AssetLoader::AssetLoader(std::shared_ptr<JobSystem> jobs)
+    : jobs(std::move(jobs)) {
+  if (!this->jobs) {
+    throw std::runtime_error("AssetLoader requires a job system");
+  }
+}
+
+AssetLoader::~AssetLoader() {
+  // Jobs capture only their own arguments, but their results are ours
+  freeAll(images, SDL_FreeSurface);
+  freeAll(sounds, [](const Sound &sound) {
+    Mix_FreeChunk(sound.chunk);
+    Mix_FreeMusic(sound.stream);
+  });
+  freeAll(music, Mix_FreeMusic);
+  freeAll(fonts, TTF_CloseFont);
+}
+
+void AssetLoader::loadImage(const std::string &filePath) {
+  if (images.count(filePath))
+    return;
+  images.emplace(filePath, jobs->submit([filePath]() {
+    SDL_RWops *source = Vfs::resources().open(filePath);
+    SDL_Surface *surface = source ? IMG_Load_RW(source, 1) : nullptr;
+    if (!surface) {
+      throw std::runtime_error("Failed to load image: " + filePath + " - " +
+                               IMG_GetError());
+    }
+    return surface;
+  }));
+}
+
+void AssetLoader::loadSound(const std::string &id,
+                            const std::string &filePath) {
+  if (sounds.count(id))
+    return;
+  sounds.emplace(id, jobs->submit([id, filePath]() {
+    Sound sound;
+    sound.stream = AudioManager::openStreamedSound(filePath.c_str());
+    if (sound.stream)
+      return sound;
+    SDL_RWops *source = Vfs::resources().open(filePath);
+    sound.chunk = source ? Mix_LoadWAV_RW(source, 1) : nullptr;
+    if (!sound.chunk) {
+      throw std::runtime_error("Failed to load sound '" + id +
+                               "' from: " + filePath + " - " + Mix_GetError());
+    }
+    return sound;
+  }));
+}
+
+void AssetLoader::loadMusic(const std::string &filePath) {
+  if (music.count(filePath))
+    return;
+  music.emplace(filePath, jobs->submit([filePath]() {
+    SDL_RWops *source = Vfs::resources().open(filePath);
+    Mix_Music *mus = source ? Mix_LoadMUS_RW(source, 1) : nullptr;
+    if (!mus) {
+      throw std::runtime_error("Failed to load music from: " + filePath +
+                               " - " + Mix_GetError());
+    }
+    return mus;
+  }));
+}
+
+void AssetLoader::loadFont(const std::string &filePath, int pointSize) {
+  if (fonts.count(filePath))
+    return;
+  fonts.emplace(filePath, jobs->submit([filePath, pointSize]() {
+    SDL_RWops *source = Vfs::resources().open(filePath);
+    TTF_Font *font = source ? TTF_OpenFontRW(source, 1, pointSize) : nullptr;
+    if (!font) {
+      throw std::runtime_error("Failed to load font: " + filePath + " - " +
+                               TTF_GetError());
+    }
+    return font;
+  }));
+}
+
+void AssetLoader::wait() {
+  waitAll(images);
+  waitAll(sounds);
+  waitAll(music);
+  waitAll(fonts);
+}
+
+AssetLoader::SurfacePtr AssetLoader::takeImage(const std::string &filePath) {
+  return SurfacePtr(take(images, filePath, "Image"), SDL_FreeSurface);
+}
+
+AssetLoader::Sound AssetLoader::takeSound(const std::string &id) {
+  return take(sounds, id, "Sound");
+}
+
+Mix_Music *AssetLoader::takeMusic(const std::string &filePath) {
+  return take(music, filePath, "Music");
+}
+
+TTF_Font *AssetLoader::takeFont(const std::string &filePath) {
+  return take(fonts, filePath, "Font");
+}
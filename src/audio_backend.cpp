@@ -0,0 +1,289 @@
+#include "../include/audio_backend.h"
+#include <algorithm>
+#include <stdexcept>
+#include <string>
+
+// === SdlMixerAudioBackend ===
+
+SdlMixerAudioBackend::SdlMixerAudioBackend() : music(nullptr, Mix_FreeMusic) {}
+
+SdlMixerAudioBackend::~SdlMixerAudioBackend() { close(); }
+
+void SdlMixerAudioBackend::open(int frequency, Uint16 format, int channels,
+                                int chunksize) {
+  if (opened)
+    return;
+
+  // Initialize SDL_mixer
+  if (Mix_OpenAudio(frequency, format, channels, chunksize) < 0) {
+    throw std::runtime_error("Failed to initialize SDL_mixer: " +
+                             std::string(Mix_GetError()));
+  }
+  opened = true;
+
+  // The positional effect works on 16-bit stereo output
+  int openedFrequency = 0, openedChannels = 0;
+  Uint16 openedFormat = 0;
+  if (Mix_QuerySpec(&openedFrequency, &openedFormat, &openedChannels)) {
+    stereoS16 = openedFormat == AUDIO_S16SYS && openedChannels == 2;
+  }
+}
+
+void SdlMixerAudioBackend::close() {
+  if (!opened)
+    return;
+  Mix_HaltChannel(-1);
+  Mix_HaltMusic();
+  pending = PendingTrack{};
+  sounds.clear();
+  streams.clear();
+  soundBytes = 0;
+  music.reset();
+  Mix_CloseAudio();
+  opened = false;
+}
+
+void SdlMixerAudioBackend::setVoiceCount(int count) {
+  voiceCount = std::max(0, count);
+  Mix_AllocateChannels(voiceCount);
+
+  // Voices start at unity gain
+  voiceGains.reset(new std::atomic<Uint32>[voiceCount]);
+  for (int voice = 0; voice < voiceCount; ++voice) {
+    voiceGains[voice].store((32768u << 16) | 32768u);
+  }
+}
+
+bool SdlMixerAudioBackend::addSound(SoundHandle sound, Mix_Chunk *chunk) {
+  if (!opened || !chunk) {
+    if (chunk)
+      Mix_FreeChunk(chunk);
+    return false;
+  }
+
+  // Volume is applied once here, not on every play
+  Mix_VolumeChunk(chunk, soundVolume);
+  soundBytes -= getSoundBytes(sound);
+  sounds.erase(sound);
+  sounds.emplace(sound, ChunkPtr(chunk, Mix_FreeChunk));
+  soundBytes += chunk->alen;
+  return true;
+}
+
+bool SdlMixerAudioBackend::hasSound(SoundHandle sound) const {
+  return sounds.count(sound) > 0;
+}
+
+void SdlMixerAudioBackend::setSoundVolume(int volume) {
+  soundVolume = volume;
+  for (auto &sound : sounds) {
+    Mix_VolumeChunk(sound.second.get(), soundVolume);
+  }
+}
+
+size_t SdlMixerAudioBackend::getSoundBytes(SoundHandle sound) const {
+  auto it = sounds.find(sound);
+  return it == sounds.end() ? 0 : it->second->alen;
+}
+
+bool SdlMixerAudioBackend::addStream(SoundHandle sound, Mix_Music *stream) {
+  if (!opened || !stream) {
+    if (stream)
+      Mix_FreeMusic(stream);
+    return false;
+  }
+
+  // Freeing a track that is playing or queued stops it
+  auto it = streams.find(sound);
+  if (it != streams.end()) {
+    if (pending.track == it->second.get())
+      pending = PendingTrack{};
+    streams.erase(it);
+  }
+  streams.emplace(sound, MusicPtr(stream, Mix_FreeMusic));
+  return true;
+}
+
+bool SdlMixerAudioBackend::hasStream(SoundHandle sound) const {
+  return streams.count(sound) > 0;
+}
+
+bool SdlMixerAudioBackend::playStream(SoundHandle sound, int loops,
+                                      int volume, int fadeMs) {
+  auto it = streams.find(sound);
+  if (it == streams.end())
+    return false;
+  return startTrack(it->second.get(), loops, volume, fadeMs);
+}
+
+bool SdlMixerAudioBackend::setMusic(Mix_Music *mus) {
+  if (!opened || !mus) {
+    if (mus)
+      Mix_FreeMusic(mus);
+    return false;
+  }
+  if (music && pending.track == music.get())
+    pending = PendingTrack{};
+  music.reset(mus);
+  return true;
+}
+
+bool SdlMixerAudioBackend::playMusic(int loops, int volume, int fadeMs) {
+  if (!music)
+    return false;
+  return startTrack(music.get(), loops, volume, fadeMs);
+}
+
+bool SdlMixerAudioBackend::startTrack(Mix_Music *track, int loops, int volume,
+                                      int fadeMs) {
+  if (!opened)
+    return false;
+
+  // Something is audible: fade it out first; beginTick() starts the track
+  if (fadeMs > 0 && Mix_PlayingMusic()) {
+    if (!pending.track)
+      Mix_FadeOutMusic(fadeMs);
+    pending = PendingTrack{track, loops, volume, fadeMs};
+    return true;
+  }
+
+  pending = PendingTrack{};
+  Mix_VolumeMusic(volume);
+  if (fadeMs > 0)
+    return Mix_FadeInMusic(track, loops, fadeMs) != -1;
+  return Mix_PlayMusic(track, loops) != -1;
+}
+
+void SdlMixerAudioBackend::haltMusic() {
+  if (!opened)
+    return;
+  pending = PendingTrack{};
+  Mix_HaltMusic();
+}
+
+void SdlMixerAudioBackend::setMusicVolume(int volume) {
+  if (!opened)
+    return;
+  pending.volume = volume;
+  Mix_VolumeMusic(volume);
+}
+
+void SdlMixerAudioBackend::beginTick(std::uint64_t) {
+  // The outgoing track has faded to silence: bring in the queued one
+  if (pending.track && !Mix_PlayingMusic()) {
+    PendingTrack next = pending;
+    pending = PendingTrack{};
+    Mix_VolumeMusic(next.volume);
+    Mix_FadeInMusic(next.track, next.loops, next.fadeMs);
+  }
+}
+
+bool SdlMixerAudioBackend::play(int voice, SoundHandle sound, int loops,
+                                bool positional, float left, float right) {
+  auto it = sounds.find(sound);
+  if (it == sounds.end() || voice < 0 || voice >= voiceCount)
+    return false;
+
+  setGains(voice, left, right);
+
+  // SDL_mixer drops a channel's effects when it stops, so register anew
+  if (positional && stereoS16)
+    Mix_RegisterEffect(voice, positionEffect, nullptr, this);
+
+  return Mix_PlayChannel(voice, it->second.get(), loops) != -1;
+}
+
+bool SdlMixerAudioBackend::isPlaying(int voice) const {
+  return opened && Mix_Playing(voice) != 0;
+}
+
+void SdlMixerAudioBackend::halt(int voice) {
+  if (opened)
+    Mix_HaltChannel(voice);
+}
+
+void SdlMixerAudioBackend::setGains(int voice, float left, float right) {
+  if (voice < 0 || voice >= voiceCount)
+    return;
+  if (stereoS16) {
+    Uint32 l = static_cast<Uint32>(left * 32768.0f);
+    Uint32 r = static_cast<Uint32>(right * 32768.0f);
+    voiceGains[voice].store((l << 16) | r, std::memory_order_relaxed);
+  } else {
+    // No effect available: attenuate with the channel volume
+    Mix_Volume(voice,
+               static_cast<int>(std::max(left, right) * MIX_MAX_VOLUME));
+  }
+}
+
+void SdlMixerAudioBackend::positionEffect(int channel, void *stream,
+                                          int length, void *userData) {
+  auto *self = static_cast<SdlMixerAudioBackend *>(userData);
+  if (channel < 0 || channel >= self->voiceCount)
+    return;
+
+  const Uint32 gains =
+      self->voiceGains[channel].load(std::memory_order_relaxed);
+  const int left = static_cast<int>(gains >> 16);
+  const int right = static_cast<int>(gains & 0xFFFF);
+
+  // Interleaved 16-bit stereo frames
+  auto *samples = static_cast<Sint16 *>(stream);
+  const int count = length / static_cast<int>(sizeof(Sint16));
+  for (int i = 0; i + 1 < count; i += 2) {
+    samples[i] = static_cast<Sint16>((samples[i] * left) >> 15);
+    samples[i + 1] = static_cast<Sint16>((samples[i + 1] * right) >> 15);
+  }
+}
+
+// === NullAudioBackend ===
+
+bool NullAudioBackend::addSound(SoundHandle sound, Mix_Chunk *chunk) {
+  if (chunk)
+    Mix_FreeChunk(chunk); // Never played
+  sounds.insert(sound);
+  return true;
+}
+
+bool NullAudioBackend::hasSound(SoundHandle sound) const {
+  return sounds.count(sound) > 0;
+}
+
+bool NullAudioBackend::addStream(SoundHandle sound, Mix_Music *stream) {
+  if (stream)
+    Mix_FreeMusic(stream);
+  streams.insert(sound);
+  return true;
+}
+
+bool NullAudioBackend::hasStream(SoundHandle sound) const {
+  return streams.count(sound) > 0;
+}
+
+bool NullAudioBackend::setMusic(Mix_Music *music) {
+  if (music)
+    Mix_FreeMusic(music);
+  return true;
+}
+
+// === RecordingAudioBackend ===
+
+bool RecordingAudioBackend::play(int /*voice*/, SoundHandle sound, int loops,
+                                 bool /*positional*/, float left,
+                                 float right) {
+  if (!hasSound(sound))
+    return false;
+  float volume = static_cast<float>(soundVolume) / MIX_MAX_VOLUME *
+                 std::max(left, right);
+  events.push_back(Event{currentTick, sound, volume, left, right, loops});
+  return true;
+}
+
+bool RecordingAudioBackend::playStream(SoundHandle sound, int loops,
+                                       int volume, int) {
+  if (!hasStream(sound))
+    return false;
+  float level = static_cast<float>(volume) / MIX_MAX_VOLUME;
+  events.push_back(Event{currentTick, sound, level, 1.0f, 1.0f, loops});
+  return true;
+}
@@ -1,18 +1,26 @@
 #include "../include/audio_manager.h"
+#include "../include/vfs.h"
 #include <algorithm>
+#include <array>
+#include <cctype>
+#include <cmath>
+#include <filesystem>
 #include <iostream>
 #include <stdexcept>
 
-AudioManager::AudioManager() : music(nullptr, [](Mix_Music *) {}) {
+AudioManager::AudioManager(std::unique_ptr<AudioBackend> backend)
+    : backend(std::move(backend)),
+      emitters(static_cast<size_t>(voices.getVoiceCount())) {
   // Empty constructor - initialization happens in init()
+  if (!this->backend) {
+    this->backend = std::make_unique<SdlMixerAudioBackend>();
+  }
 }
 
 AudioManager::~AudioManager() {
   if (initialized) {
     stopAll();
-    sounds.clear();
-    music.reset();
-    Mix_CloseAudio();
+    backend->close();
   }
 }
 
@@ -23,11 +31,11 @@ void AudioManager::init(int frequency, Uint16 format, int channels,
     return;
   }
 
-  // Initialize SDL_mixer
-  if (Mix_OpenAudio(frequency, format, channels, chunksize) < 0) {
-    throw std::runtime_error("Failed to initialize SDL_mixer: " +
-                             std::string(Mix_GetError()));
-  }
+  backend->open(frequency, format, channels, chunksize);
+
+  // One output voice (mixer channel) per managed voice
+  backend->setVoiceCount(voices.getVoiceCount());
+  backend->setSoundVolume(std::max(0, std::min(soundVolume, MIX_MAX_VOLUME)));
 
   initialized = true;
   std::cout << "AudioManager initialized: " << frequency << "Hz, " << channels
@@ -45,16 +53,30 @@ bool AudioManager::loadSound(const std::string &id, const char *filePath) {
     return false;
   }
 
+  // Outputs that never play samples only need the sound registered
+  if (!backend->needsSampleData()) {
+    SoundHandle sound;
+    return claimHandle(id, sound) && backend->addSound(sound, nullptr);
+  }
+
+  // Long sounds are streamed, never decoded into memory
+  if (Mix_Music *stream = openStreamedSound(filePath)) {
+    std::cout << "Streaming sound: " << id << " from " << filePath
+              << std::endl;
+    return addStreamedSound(id, stream);
+  }
+
   // Load the chunk
-  Mix_Chunk *chunk = Mix_LoadWAV(filePath);
+  SDL_RWops *source = Vfs::resources().open(filePath);
+  Mix_Chunk *chunk = source ? Mix_LoadWAV_RW(source, 1) : nullptr;
   if (!chunk) {
     std::cerr << "Failed to load sound '" << id << "' from: " << filePath
               << " - " << Mix_GetError() << std::endl;
     return false;
   }
 
-  // Store in map with RAII wrapper
-  sounds.emplace(id, makeChunkPtr(chunk));
+  if (!addSound(id, chunk))
+    return false;
   std::cout << "Loaded sound: " << id << " from " << filePath << std::endl;
   return true;
 }
@@ -70,69 +92,297 @@ bool AudioManager::loadMusic(const char *filePath) {
     return false;
   }
 
+  if (!backend->needsSampleData()) {
+    return backend->setMusic(nullptr);
+  }
+
   // Load the music
-  Mix_Music *mus = Mix_LoadMUS(filePath);
+  SDL_RWops *source = Vfs::resources().open(filePath);
+  Mix_Music *mus = source ? Mix_LoadMUS_RW(source, 1) : nullptr;
   if (!mus) {
     std::cerr << "Failed to load music from: " << filePath << " - "
               << Mix_GetError() << std::endl;
     return false;
   }
 
-  // Store with RAII wrapper
-  music = makeMusicPtr(mus);
+  backend->setMusic(mus);
   std::cout << "Loaded music from " << filePath << std::endl;
   return true;
 }
 
-int AudioManager::playSound(const std::string &id, int loops) {
-  if (!initialized) {
-    std::cerr << "AudioManager not initialized" << std::endl;
-    return -1;
+bool AudioManager::addSound(const std::string &id, Mix_Chunk *chunk) {
+  if (!initialized || (!chunk && backend->needsSampleData())) {
+    if (chunk)
+      Mix_FreeChunk(chunk);
+    std::cerr << "Cannot add sound: " << id << std::endl;
+    return false;
   }
 
-  // Find the sound
-  auto it = sounds.find(id);
-  if (it == sounds.end()) {
-    std::cerr << "Sound not found: " << id << std::endl;
-    return -1;
+  SoundHandle sound;
+  if (!claimHandle(id, sound)) {
+    if (chunk)
+      Mix_FreeChunk(chunk);
+    return false;
   }
 
-  Mix_Chunk *chunk = it->second.get();
-  if (!chunk) {
-    std::cerr << "Invalid chunk for sound: " << id << std::endl;
-    return -1;
+  // Keep decoded audio within budget; a replaced sound frees its bytes
+  if (chunk && getTotalSoundBytes() - getSoundBytes(sound) + chunk->alen >
+                   AUDIO_MEMORY_BUDGET_BYTES) {
+    std::cerr << "Audio memory budget exceeded, dropping sound: " << id
+              << " (" << chunk->alen << " bytes)" << std::endl;
+    Mix_FreeChunk(chunk);
+    return false;
   }
+  return backend->addSound(sound, chunk);
+}
 
-  int mixVolume = std::max(0, std::min(soundVolume, MIX_MAX_VOLUME));
-  Mix_VolumeChunk(chunk, mixVolume);
+bool AudioManager::addStreamedSound(const std::string &id,
+                                    Mix_Music *stream) {
+  if (!initialized || (!stream && backend->needsSampleData())) {
+    if (stream)
+      Mix_FreeMusic(stream);
+    std::cerr << "Cannot add streamed sound: " << id << std::endl;
+    return false;
+  }
 
-  // Play on first available channel
-  int channel = Mix_PlayChannel(-1, chunk, loops);
-  if (channel == -1) {
-    std::cerr << "Failed to play sound '" << id << "': " << Mix_GetError()
-              << std::endl;
+  SoundHandle sound;
+  if (!claimHandle(id, sound)) {
+    if (stream)
+      Mix_FreeMusic(stream);
+    return false;
   }
+  return backend->addStream(sound, stream);
+}
 
-  return channel;
+bool AudioManager::claimHandle(const std::string &id, SoundHandle &handle) {
+  handle = hashSoundName(id.c_str());
+  auto registered = soundNames.emplace(handle, id).first;
+  if (registered->second != id) {
+    std::cerr << "Sound '" << id << "' collides with '" << registered->second
+              << "' (handle " << handle << "), not registered" << std::endl;
+    return false;
+  }
+  return true;
 }
 
-bool AudioManager::playMusic(int loops) {
-  if (!initialized) {
-    std::cerr << "AudioManager not initialized" << std::endl;
+Mix_Music *AudioManager::openStreamedSound(const char *filePath) {
+  if (!filePath)
+    return nullptr;
+  SDL_RWops *source = Vfs::resources().open(filePath);
+  if (!source)
+    return nullptr; // Let the decode report the error
+  const Sint64 fileBytes = SDL_RWsize(source);
+  Mix_Music *stream = Mix_LoadMUS_RW(source, 1);
+  if (!stream)
+    return nullptr;
+
+  size_t decodedBytes = 0;
+#ifdef SDL_MIXER_VERSION_ATLEAST
+#if SDL_MIXER_VERSION_ATLEAST(2, 6, 0)
+  // Exact: duration times the output format Mix_LoadWAV converts to
+  int frequency = 0, channels = 0;
+  Uint16 format = 0;
+  const double seconds = Mix_MusicDuration(stream);
+  if (seconds > 0.0 && Mix_QuerySpec(&frequency, &format, &channels)) {
+    decodedBytes = static_cast<size_t>(seconds * frequency * channels *
+                                       SDL_AUDIO_BITSIZE(format) / 8);
+  }
+#endif
+#endif
+
+  // Fall back to the file size: WAV is already PCM, everything else
+  // (MP3, OGG, FLAC...) is assumed compressed
+  if (decodedBytes == 0 && fileBytes > 0) {
+    std::string extension =
+        std::filesystem::path(filePath).extension().string();
+    std::transform(extension.begin(), extension.end(), extension.begin(),
+                   [](unsigned char c) { return std::tolower(c); });
+    decodedBytes = static_cast<size_t>(fileBytes);
+    if (extension != ".wav")
+      decodedBytes *= AUDIO_COMPRESSED_RATIO;
+  }
+
+  if (decodedBytes < AUDIO_STREAM_THRESHOLD_BYTES) {
+    Mix_FreeMusic(stream);
+    return nullptr;
+  }
+  return stream;
+}
+
+bool AudioManager::setMusic(Mix_Music *mus) {
+  if (!initialized || (!mus && backend->needsSampleData())) {
+    if (mus)
+      Mix_FreeMusic(mus);
+    std::cerr << "Cannot set music" << std::endl;
     return false;
   }
+  return backend->setMusic(mus);
+}
+
+bool AudioManager::playSound(SoundHandle sound, int loops) {
+  // Dropping a sound under a burst beats stalling gameplay
+  return commands.push(PlayCommand{sound, loops, false, 0.0f, 0.0f});
+}
+
+bool AudioManager::playSoundAt(SoundHandle sound, float worldX, float worldY,
+                               int loops) {
+  return commands.push(PlayCommand{sound, loops, true, worldX, worldY});
+}
+
+void AudioManager::setListener(float worldX, float worldY) {
+  listenerX = worldX;
+  listenerY = worldY;
+}
+
+void AudioManager::update() {
+  // Merge duplicate requests: one trigger per sound per update
+  std::array<PlayCommand, AUDIO_COMMAND_QUEUE_SIZE> batch;
+  size_t count = 0;
+  PlayCommand command;
+  while (commands.pop(command)) {
+    auto end = batch.begin() + count;
+    auto same = std::find_if(batch.begin(), end, [&](const PlayCommand &c) {
+      return c.sound == command.sound;
+    });
+    if (same == end) {
+      if (count < batch.size())
+        batch[count++] = command;
+      continue;
+    }
+
+    // Keep the longest request; -1 (forever) beats any count
+    if (same->loops != -1 &&
+        (command.loops == -1 || command.loops > same->loops))
+      same->loops = command.loops;
+
+    // Keep the loudest position: non-positional, else nearest the listener
+    if (same->positional) {
+      float dx = same->x - listenerX, dy = same->y - listenerY;
+      float cx = command.x - listenerX, cy = command.y - listenerY;
+      if (!command.positional || cx * cx + cy * cy < dx * dx + dy * dy) {
+        same->positional = command.positional;
+        same->x = command.x;
+        same->y = command.y;
+      }
+    }
+  }
+
+  if (!initialized)
+    return;
+
+  backend->beginTick(tick++);
+  reclaimVoices();
+
+  for (size_t i = 0; i < count; ++i) {
+    const PlayCommand &request = batch[i];
+
+    // Long sounds take over the music stream instead of a voice
+    if (backend->hasStream(request.sound)) {
+      int mixVolume = std::max(0, std::min(musicVolume, MIX_MAX_VOLUME));
+      if (!backend->playStream(request.sound, request.loops, mixVolume,
+                               AUDIO_CROSSFADE_MS))
+        ++droppedSounds;
+      continue;
+    }
+
+    // Find the sound
+    if (!backend->hasSound(request.sound)) {
+      std::cerr << "Sound not found: " << request.sound << std::endl;
+      continue;
+    }
+
+    // Inaudible sounds never take a voice
+    float left = 1.0f, right = 1.0f;
+    if (request.positional &&
+        !computeGains(request.x, request.y, left, right)) {
+      ++culledSounds;
+      continue;
+    }
+
+    int voice = voices.allocate(request.sound);
+    if (voice < 0) {
+      ++droppedSounds; // Everything playing outranks this sound
+      continue;
+    }
+
+    // The voice may be stolen from a sound that is still playing
+    if (backend->isPlaying(voice))
+      backend->halt(voice);
+
+    emitters[voice] = {request.positional, request.x, request.y};
+    if (!backend->play(voice, request.sound, request.loops,
+                       request.positional, left, right)) {
+      voices.release(voice);
+      ++droppedSounds;
+    }
+  }
+
+  updateVoiceGains();
+}
+
+void AudioManager::setSoundParams(SoundHandle sound, int priority,
+                                  int maxInstances) {
+  VoiceManager::SoundParams params;
+  params.priority = priority;
+  params.maxInstances = maxInstances;
+  voices.setParams(sound, params);
+}
+
+void AudioManager::reclaimVoices() {
+  for (int voice = 0; voice < voices.getVoiceCount(); ++voice) {
+    if (voices.isActive(voice) && !backend->isPlaying(voice))
+      voices.release(voice);
+  }
+}
 
-  if (!music || !music.get()) {
-    std::cerr << "No music loaded" << std::endl;
+bool AudioManager::computeGains(float x, float y, float &left,
+                                float &right) const {
+  const float dx = x - listenerX;
+  const float dy = y - listenerY;
+  const float distance = std::sqrt(dx * dx + dy * dy);
+  if (distance >= AUDIO_MAX_DISTANCE)
     return false;
+
+  // Full volume up close, then a linear falloff to silence at max range
+  float gain = 1.0f;
+  if (distance > AUDIO_FULL_VOLUME_DISTANCE) {
+    gain = (AUDIO_MAX_DISTANCE - distance) /
+           (AUDIO_MAX_DISTANCE - AUDIO_FULL_VOLUME_DISTANCE);
+  }
+
+  // Balance pan: the far ear fades, the near ear stays at the distance gain
+  const float pan = std::max(-1.0f, std::min(1.0f, dx / AUDIO_PAN_DISTANCE));
+  left = gain * std::min(1.0f, 1.0f - pan);
+  right = gain * std::min(1.0f, 1.0f + pan);
+  return true;
+}
+
+void AudioManager::updateVoiceGains() {
+  for (int voice = 0; voice < voices.getVoiceCount(); ++voice) {
+    if (!voices.isActive(voice) || !emitters[voice].positional)
+      continue;
+
+    float left, right;
+    if (!computeGains(emitters[voice].x, emitters[voice].y, left, right)) {
+      // Listener moved out of range: stop mixing it at all
+      backend->halt(voice);
+      voices.release(voice);
+      ++culledSounds;
+      continue;
+    }
+    backend->setGains(voice, left, right);
   }
+}
 
-  // Set music volume (0-128)
-  int mixVolume = std::max(0, std::min(musicVolume, 128));
-  Mix_VolumeMusic(mixVolume);
+bool AudioManager::playMusic(int loops, int fadeMs) {
+  if (!initialized) {
+    std::cerr << "AudioManager not initialized" << std::endl;
+    return false;
+  }
 
-  // Play the music
-  if (Mix_PlayMusic(music.get(), loops) == -1) {
+  // Set music volume (0-128) and play
+  int mixVolume = std::max(0, std::min(musicVolume, MIX_MAX_VOLUME));
+  if (!backend->playMusic(loops, mixVolume, fadeMs)) {
     std::cerr << "Failed to play music: " << Mix_GetError() << std::endl;
     return false;
   }
@@ -144,22 +394,22 @@ void AudioManager::stopAll() {
   if (!initialized)
     return;
 
-  Mix_HaltChannel(-1); // Stop all sound effects
-  Mix_HaltMusic();     // Stop music
+  backend->halt(-1);   // Stop all sound effects
+  backend->haltMusic(); // Stop music
 }
 
 void AudioManager::stopAllSounds() {
   if (!initialized)
     return;
 
-  Mix_HaltChannel(-1); // Stop all sound effects
+  backend->halt(-1); // Stop all sound effects
 }
 
 void AudioManager::stopMusic() {
   if (!initialized)
     return;
 
-  Mix_HaltMusic();
+  backend->haltMusic();
 }
 
 void AudioManager::setSoundVolume(int volume) {
@@ -168,30 +418,13 @@ void AudioManager::setSoundVolume(int volume) {
     return;
   }
   soundVolume = std::max(0, std::min(volume, MIX_MAX_VOLUME));
+  backend->setSoundVolume(soundVolume);
 }
 
 void AudioManager::setMusicVolume(int volume) {
-  musicVolume = std::max(0, std::min(volume, 128));
+  musicVolume = std::max(0, std::min(volume, MIX_MAX_VOLUME));
 
   if (initialized) {
-    int mixVolume = static_cast<int>(musicVolume * MIX_MAX_VOLUME);
-    Mix_VolumeMusic(mixVolume);
+    backend->setMusicVolume(musicVolume);
   }
 }
-
-// Helper functions for RAII wrappers
-AudioManager::ChunkPtr AudioManager::makeChunkPtr(Mix_Chunk *chunk) {
-  return ChunkPtr(chunk, [](Mix_Chunk *c) {
-    if (c) {
-      Mix_FreeChunk(c);
-    }
-  });
-}
-
-AudioManager::MusicPtr AudioManager::makeMusicPtr(Mix_Music *music) {
-  return MusicPtr(music, [](Mix_Music *m) {
-    if (m) {
-      Mix_FreeMusic(m);
-    }
-  });
-}
@@ -0,0 +1,167 @@
+#include "../include/chunk_streamer.h"
+#include "../include/layer.h"
+#include "../include/tmx_reader.h"
+#include "../include/vfs.h"
+#include <algorithm>
+#include <cstdlib>
+#include <iostream>
+
+ChunkStreamer::ChunkStreamer(const std::string &tmxFilePath, int chunkWidth,
+                             int chunkHeight, Builder builder,
+                             int prefetchRadius, size_t memoryBudget)
+    : tmxFilePath(tmxFilePath), chunkWidth(std::max(1, chunkWidth)),
+      chunkHeight(std::max(1, chunkHeight)), builder(std::move(builder)),
+      prefetchRadius(std::max(0, prefetchRadius)),
+      memoryBudget(memoryBudget) {
+  worker = std::thread([this]() { workerLoop(); });
+}
+
+ChunkStreamer::~ChunkStreamer() {
+  {
+    std::lock_guard<std::mutex> lock(mutex);
+    stopping = true;
+  }
+  wake.notify_all();
+  if (worker.joinable()) {
+    worker.join();
+  }
+}
+
+void ChunkStreamer::addChunk(const ChunkRequest &request) {
+  index[request.id] = request;
+  maxLayer = std::max(maxLayer, request.id.layer);
+}
+
+ChunkStreamer::Update ChunkStreamer::update(int focusTileX, int focusTileY) {
+  Update result;
+  const int focusX = Layer::floorDiv(focusTileX, chunkWidth);
+  const int focusY = Layer::floorDiv(focusTileY, chunkHeight);
+
+  std::vector<ChunkLoad> finished;
+  {
+    std::lock_guard<std::mutex> lock(mutex);
+
+    // Forget queued requests the focus has already moved away from
+    auto stale = std::remove_if(
+        requests.begin(), requests.end(), [&](const ChunkRequest &request) {
+          if (distance(request.id, focusX, focusY) <= prefetchRadius)
+            return false;
+          pending.erase(request.id);
+          return true;
+        });
+    requests.erase(stale, requests.end());
+
+    // Request everything inside the prefetch radius, nearest first
+    for (int ring = 0; ring <= prefetchRadius; ++ring) {
+      for (int dy = -ring; dy <= ring; ++dy) {
+        for (int dx = -ring; dx <= ring; ++dx) {
+          if (std::max(std::abs(dx), std::abs(dy)) != ring)
+            continue;
+          for (int layer = 0; layer <= maxLayer; ++layer) {
+            ChunkId id{layer, focusX + dx, focusY + dy};
+            auto it = index.find(id);
+            if (it == index.end() || resident.count(id) || pending.count(id))
+              continue;
+            pending.insert(id);
+            requests.push_back(it->second);
+          }
+        }
+      }
+    }
+
+    finished.swap(completed);
+  }
+  wake.notify_one();
+
+  // Accept finished chunks unless the focus has moved well past them
+  for (auto &load : finished) {
+    pending.erase(load.id);
+    if (distance(load.id, focusX, focusY) > prefetchRadius + 1)
+      continue;
+    resident[load.id] = load.bytes;
+    residentBytes += load.bytes;
+    result.loaded.push_back(std::move(load));
+  }
+
+  // Over budget: evict cached chunks outside the radius, farthest first
+  if (residentBytes > memoryBudget) {
+    std::vector<std::pair<int, ChunkId>> candidates;
+    for (const auto &entry : resident) {
+      int d = distance(entry.first, focusX, focusY);
+      if (d > prefetchRadius)
+        candidates.emplace_back(d, entry.first);
+    }
+    std::sort(candidates.begin(), candidates.end(),
+              [](const std::pair<int, ChunkId> &a,
+                 const std::pair<int, ChunkId> &b) { return a.first > b.first; });
+
+    for (const auto &candidate : candidates) {
+      if (residentBytes <= memoryBudget)
+        break;
+      auto it = resident.find(candidate.second);
+      residentBytes -= it->second;
+      resident.erase(it);
+      result.evicted.push_back(candidate.second);
+    }
+  }
+
+  return result;
+}
+
+void ChunkStreamer::invalidate(const ChunkId &id) {
+  auto it = resident.find(id);
+  if (it == resident.end())
+    return;
+  residentBytes -= it->second;
+  resident.erase(it);
+}
+
+void ChunkStreamer::workerLoop() {
+  // The TMX file stays open on this thread for the streamer's lifetime
+  std::unique_ptr<SDL_RWops, int (*)(SDL_RWops *)> file(
+      nullptr, [](SDL_RWops *rw) { return rw ? SDL_RWclose(rw) : 0; });
+  std::vector<int> gids;
+
+  while (true) {
+    ChunkRequest request;
+    {
+      std::unique_lock<std::mutex> lock(mutex);
+      wake.wait(lock, [this]() { return stopping || !requests.empty(); });
+      if (stopping) {
+        return;
+      }
+      request = requests.front();
+      requests.pop_front();
+    }
+
+    ChunkLoad load;
+    load.id = request.id;
+    try {
+      if (!file) {
+        file.reset(Vfs::resources().open(tmxFilePath));
+        if (!file) {
+          throw std::runtime_error(std::string("cannot open ") +
+                                   tmxFilePath + " - " + SDL_GetError());
+        }
+      }
+      gids.clear();
+      TMXReader::readChunkData(file.get(), request.dataOffset, gids,
+                               tmxFilePath);
+      builder(request, gids, load);
+    } catch (const std::exception &e) {
+      // Deliver an empty chunk so it isn't requested again every frame
+      std::cerr << "Failed to stream chunk (" << request.id.x << ", "
+                << request.id.y << ") of layer " << request.id.layer << ": "
+                << e.what() << std::endl;
+      load = ChunkLoad{};
+      load.id = request.id;
+    }
+
+    std::lock_guard<std::mutex> lock(mutex);
+    completed.push_back(std::move(load));
+  }
+}
+
+int ChunkStreamer::distance(const ChunkId &id, int focusX, int focusY) const {
+  return std::max(std::abs(id.x - focusX), std::abs(id.y - focusY));
+}
@@ -15,22 +15,6 @@ void CollisionSystem::resolveCollisions(Collideable *player,
       handleCollision(player, obj);
     }
   }
-
-  // Check projectiles against static objects
-  /*for (size_t i = 0; i < objects.size(); ++i) {
-    if (objects[i]->getType() != ObjectType::PROJECTILE)
-      continue;
-
-    for (size_t j = 0; j < objects.size(); ++j) {
-      if (i == j || objects[j]->getType() != ObjectType::STATIC_OBJECT)
-        continue;
-
-      if (checkAABB(objects[i]->getCollisionBounds(),
-                    objects[j]->getCollisionBounds())) {
-        handleCollision(objects[i], objects[j]);
-      }
-    }
-  }*/
 }
 
 void CollisionSystem::handleCollision(Collideable *a, Collideable *b) {
@@ -43,17 +27,6 @@ void CollisionSystem::handleCollision(Collideable *a, Collideable *b) {
   } else if (typeA == ObjectType::STATIC_OBJECT &&
              typeB == ObjectType::PLAYER) {
     handlePlayerVsStatic(b, a);
-  } else if (typeA == ObjectType::PLAYER && typeB == ObjectType::PROJECTILE) {
-    handlePlayerVsProjectile(a, b);
-  } else if (typeA == ObjectType::PROJECTILE && typeB == ObjectType::PLAYER) {
-    handlePlayerVsProjectile(b, a);
-  } else if ((typeA == ObjectType::PROJECTILE &&
-              typeB == ObjectType::STATIC_OBJECT) ||
-             (typeA == ObjectType::STATIC_OBJECT &&
-              typeB == ObjectType::PROJECTILE)) {
-    Collideable *projectile = (typeA == ObjectType::PROJECTILE) ? a : b;
-    Collideable *staticObj = (typeA == ObjectType::STATIC_OBJECT) ? a : b;
-    handleProjectileVsStatic(projectile, staticObj);
   }
 }
 
@@ -74,35 +47,6 @@ void CollisionSystem::handlePlayerVsStatic(Collideable *player,
                  pos.second + normalY * penetration);
 }
 
-void CollisionSystem::handlePlayerVsProjectile(Collideable *player,
-                                               Collideable *projectile) {
-  float normalX, normalY, penetration;
-  computeCollisionInfo(player->getCollisionBounds(),
-                       projectile->getCollisionBounds(), normalX, normalY,
-                       penetration);
-
-  // Call collision callbacks (projectile handles collection/damage logic)
-  player->onCollision(projectile, normalX, normalY, penetration);
-  projectile->onCollision(player, -normalX, -normalY, penetration);
-}
-
-void CollisionSystem::handleProjectileVsStatic(Collideable *projectile,
-                                               Collideable *staticObj) {
-  float normalX, normalY, penetration;
-  computeCollisionInfo(projectile->getCollisionBounds(),
-                       staticObj->getCollisionBounds(), normalX, normalY,
-                       penetration);
-
-  // Call collision callbacks
-  projectile->onCollision(staticObj, normalX, normalY, penetration);
-  staticObj->onCollision(projectile, -normalX, -normalY, penetration);
-
-  // Move projectile out of static object
-  auto pos = projectile->getPos();
-  projectile->setPos(pos.first + normalX * penetration,
-                     pos.second + normalY * penetration);
-}
-
 void CollisionSystem::computeCollisionInfo(const SDL_FRect &a,
                                            const SDL_FRect &b, float &normalX,
                                            float &normalY, float &penetration) {
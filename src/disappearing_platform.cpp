@@ -66,6 +66,18 @@ void DisappearingPlatform::update(float dt) {
   }
 }
 
+void DisappearingPlatform::saveState(StateWriter &out) const {
+  out.write(state);
+  out.write(triggered);
+  out.write(timer);
+}
+
+void DisappearingPlatform::loadState(StateReader &in) {
+  in.read(state);
+  in.read(triggered);
+  in.read(timer);
+}
+
 SDL_FRect DisappearingPlatform::getCollisionBounds() const {
   // Return empty bounds when platform can't collide
   if (!canCollide()) {
@@ -0,0 +1,57 @@
+#include "../include/entity_registry.h"
+
+Entity EntityRegistry::create() {
+  if (!freeIds.empty()) {
+    const Entity entity = freeIds.back();
+    freeIds.pop_back();
+    states[entity] = ACTIVE;
+    return entity;
+  }
+  states.push_back(ACTIVE);
+  return static_cast<Entity>(states.size() - 1);
+}
+
+void EntityRegistry::destroy(Entity entity) {
+  if (entity >= states.size() || states[entity] == FREE)
+    return;
+  transforms.remove(entity);
+  velocities.remove(entity);
+  colliders.remove(entity);
+  sprites.remove(entity);
+  timers.remove(entity);
+  pickups.remove(entity);
+  hazards.remove(entity);
+  states[entity] = FREE;
+  freeIds.push_back(entity);
+}
+
+void EntityRegistry::clear() {
+  transforms.clear();
+  velocities.clear();
+  colliders.clear();
+  sprites.clear();
+  timers.clear();
+  pickups.clear();
+  hazards.clear();
+  states.clear();
+  freeIds.clear();
+}
+
+void EntityRegistry::setActive(Entity entity, bool active) {
+  if (entity < states.size() && states[entity] != FREE)
+    states[entity] = active ? ACTIVE : DISABLED;
+}
+
+void EntityRegistry::saveState(StateWriter &out) const {
+  out.write(states.data(), states.size());
+  out.write(transforms.data(), transforms.size());
+  out.write(velocities.data(), velocities.size());
+  out.write(timers.data(), timers.size());
+}
+
+void EntityRegistry::loadState(StateReader &in) {
+  in.read(states.data(), states.size());
+  in.read(transforms.data(), transforms.size());
+  in.read(velocities.data(), velocities.size());
+  in.read(timers.data(), timers.size());
+}
@@ -0,0 +1,126 @@
+#include "../include/entity_systems.h"
+#include "../include/collision_system.h"
+#include "../include/config.h"
+#include <cmath>
+
+namespace {
+
+// Run body(begin, end) over [0, count), in parallel if possible
+template <typename F> void forRange(JobSystem *jobs, size_t count, F &&body) {
+  if (jobs)
+    jobs->parallelFor(count, ENTITY_UPDATE_BATCH_SIZE, body);
+  else
+    body(size_t(0), count);
+}
+
+bool outside(const Component::Transform &t, const SDL_FRect &world) {
+  return t.x + t.w < world.x || t.x > world.x + world.w ||
+         t.y + t.h < world.y || t.y > world.y + world.h;
+}
+
+} // namespace
+
+void EntitySystems::move(EntityRegistry &registry, float dt,
+                         const SDL_FRect &worldBounds, JobSystem *jobs) {
+  auto &velocities = registry.velocities;
+  forRange(jobs, velocities.size(), [&](size_t begin, size_t end) {
+    for (size_t i = begin; i < end; ++i) {
+      const Entity entity = velocities.entityAt(i);
+      Component::Transform *transform = registry.transforms.find(entity);
+      if (!transform || !registry.isActive(entity))
+        continue;
+
+      transform->x += velocities[i].x * dt;
+      transform->y += velocities[i].y * dt;
+      if (!outside(*transform, worldBounds))
+        continue;
+
+      if (const Component::Hazard *hazard = registry.hazards.find(entity)) {
+        transform->x = hazard->spawnX;
+        transform->y = hazard->spawnY;
+      } else {
+        registry.setActive(entity, false);
+      }
+    }
+  });
+}
+
+void EntitySystems::animate(EntityRegistry &registry, float dt,
+                            JobSystem *jobs) {
+  auto &timers = registry.timers;
+  forRange(jobs, timers.size(), [&](size_t begin, size_t end) {
+    for (size_t i = begin; i < end; ++i) {
+      timers[i].time += dt;
+    }
+  });
+
+  // The bob is visual only; the collider stays put
+  auto &pickups = registry.pickups;
+  forRange(jobs, pickups.size(), [&](size_t begin, size_t end) {
+    for (size_t i = begin; i < end; ++i) {
+      const Entity entity = pickups.entityAt(i);
+      Component::Sprite *sprite = registry.sprites.find(entity);
+      const Component::Timer *timer = registry.timers.find(entity);
+      if (!sprite || !timer)
+        continue;
+      sprite->offsetY = std::sin(timer->time * pickups[i].bobFrequency *
+                                 2.0f * static_cast<float>(M_PI)) *
+                        pickups[i].bobAmplitude;
+    }
+  });
+}
+
+void EntitySystems::touchPlayer(const EntityRegistry &registry,
+                                const SDL_FRect &playerBounds,
+                                std::vector<Contact> &contacts,
+                                JobSystem *jobs) {
+  const auto &colliders = registry.colliders;
+  contacts.resize(colliders.size());
+
+  // Each contact is written by the index that owns it only
+  forRange(jobs, colliders.size(), [&](size_t begin, size_t end) {
+    for (size_t i = begin; i < end; ++i) {
+      Contact &contact = contacts[i];
+      const Entity entity = colliders.entityAt(i);
+      contact.hit = false;
+      if (!registry.isActive(entity) || !registry.transforms.has(entity))
+        continue;
+
+      const SDL_FRect bounds = colliderBounds(registry, entity);
+      contact.hit = CollisionSystem::checkAABB(playerBounds, bounds);
+      if (contact.hit) {
+        CollisionSystem::computeCollisionInfo(playerBounds, bounds,
+                                              contact.normalX,
+                                              contact.normalY,
+                                              contact.penetration);
+      }
+    }
+  });
+}
+
+void EntitySystems::render(const EntityRegistry &registry,
+                           RenderSnapshot &snapshot) {
+  const auto &sprites = registry.sprites;
+  for (size_t i = 0; i < sprites.size(); ++i) {
+    const Entity entity = sprites.entityAt(i);
+    const Component::Sprite &sprite = sprites[i];
+    const Component::Transform *transform = registry.transforms.find(entity);
+    if (!transform || !registry.isActive(entity) || !sprite.texture ||
+        !sprite.texture->get())
+      continue;
+
+    const SDL_FRect dest = {transform->x, transform->y + sprite.offsetY,
+                            transform->w, transform->h};
+    snapshot.sprites.push_back(RenderSnapshot::SpriteDraw{
+        sprite.texture->get(), sprite.src, dest, SDL_FLIP_NONE,
+        SDL_ALPHA_OPAQUE});
+  }
+}
+
+SDL_FRect EntitySystems::colliderBounds(const EntityRegistry &registry,
+                                        Entity entity) {
+  const Component::Transform &transform = registry.transforms.get(entity);
+  const Component::Collider &collider = registry.colliders.get(entity);
+  return SDL_FRect{transform.x + collider.offsetX,
+                   transform.y + collider.offsetY, collider.w, collider.h};
+}
@@ -0,0 +1,125 @@
+#include "../include/frame_limiter.h"
+#include <algorithm>
+#include <cstdlib>
+
+FrameLimiter::FrameLimiter(PacingMode mode, int targetFps)
+    : mode(mode), targetFps(FRAME_CAP_DEFAULT_FPS),
+      frequency(SDL_GetPerformanceFrequency()) {
+  setMode(mode, targetFps);
+}
+
+void FrameLimiter::setMode(PacingMode newMode, int newTargetFps) {
+  mode = newMode;
+  if (newTargetFps > 0) {
+    targetFps = newTargetFps;
+  }
+  period = frequency / static_cast<Uint64>(targetFps);
+  reset();
+  resetStats();
+}
+
+void FrameLimiter::setRefreshRate(int hz) {
+  refreshPeriod = hz > 0 ? frequency / static_cast<Uint64>(hz) : 0;
+}
+
+void FrameLimiter::reset() {
+  deadline = 0;
+  lastFrame = 0;
+}
+
+void FrameLimiter::endFrame(const std::function<void()> &whileWaiting) {
+  if (mode == PacingMode::CAPPED && !waitForDeadline(whileWaiting)) {
+    ++stats.missedDeadlines;
+  }
+
+  const Uint64 now = SDL_GetPerformanceCounter();
+  if (lastFrame != 0) {
+    record(now - lastFrame);
+  }
+  lastFrame = now;
+}
+
+bool FrameLimiter::waitForDeadline(
+    const std::function<void()> &whileWaiting) {
+  Uint64 now = SDL_GetPerformanceCounter();
+  if (deadline == 0) {
+    deadline = now + period; // First frame: start the schedule here
+    return true;
+  }
+  if (now >= deadline) {
+    // Late: restart the schedule rather than rushing to catch up
+    deadline = now + period;
+    return false;
+  }
+
+  // SDL_Delay can overshoot by a scheduler quantum, so stop sleeping a
+  // little early and spin the rest
+  const Uint64 spinTicks = frequency * FRAME_SPIN_THRESHOLD_MS / 1000;
+  while (now < deadline) {
+    const Uint64 remaining = deadline - now;
+    if (remaining > spinTicks) {
+      Uint32 sleepMs =
+          static_cast<Uint32>((remaining - spinTicks) * 1000 / frequency);
+      if (whileWaiting) {
+        sleepMs = std::min<Uint32>(sleepMs, 1); // Short naps, work between
+      }
+      SDL_Delay(sleepMs);
+      if (whileWaiting) {
+        whileWaiting();
+      }
+    }
+    now = SDL_GetPerformanceCounter();
+  }
+
+  deadline += period;
+  return true;
+}
+
+void FrameLimiter::record(Uint64 frameTicks) {
+  if (mode == PacingMode::VSYNC && refreshPeriod != 0 &&
+      frameTicks > refreshPeriod * FRAME_MISSED_TOLERANCE) {
+    ++stats.missedDeadlines;
+  }
+
+  // Welford's running mean and variance
+  const double frameMs = frameTicks * 1000.0 / frequency;
+  ++stats.frames;
+  const double delta = frameMs - stats.meanMs;
+  stats.meanMs += delta / stats.frames;
+  sumSquares += delta * (frameMs - stats.meanMs);
+  stats.varianceMs2 = stats.frames > 1 ? sumSquares / (stats.frames - 1) : 0.0;
+  stats.worstMs = std::max(stats.worstMs, frameMs);
+}
+
+const char *FrameLimiter::modeName(PacingMode mode) {
+  switch (mode) {
+  case PacingMode::VSYNC:
+    return "vsync";
+  case PacingMode::UNCAPPED:
+    return "uncapped";
+  case PacingMode::CAPPED:
+    return "capped";
+  }
+  return "unknown";
+}
+
+bool FrameLimiter::parseMode(const std::string &text, PacingMode &mode,
+                             int &targetFps) {
+  if (text == "vsync") {
+    mode = PacingMode::VSYNC;
+    return true;
+  }
+  if (text == "uncapped") {
+    mode = PacingMode::UNCAPPED;
+    return true;
+  }
+
+  char *end = nullptr;
+  const long fps = std::strtol(text.c_str(), &end, 10);
+  if (text.empty() || *end != '\0' || fps <= 0 || fps > 1000) {
+    return false;
+  }
+  mode = PacingMode::CAPPED;
+  targetFps = static_cast<int>(fps);
+  return true;
+}
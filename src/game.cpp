@@ -1,10 +1,49 @@
 #include "../include/game.h"
-#include "../include/collision_system.h"
+#include "../include/asset_loader.h"
 #include "../include/config.h"
+#include "../include/entity_systems.h"
 #include "../include/platform.h"
+#include "../include/tile_mover.h"
 #include <SDL2/SDL_image.h>
+#include <algorithm>
+#include <chrono>
+#include <cmath>
 #include <iostream>
 #include <memory>
+
+namespace {
+
+constexpr float PI = static_cast<float>(M_PI);
+
+// Gold sparks thrown up from a collected coin
+constexpr ParticleEmitter COIN_BURST = {
+    24, -PI / 2, PI, // Count, upwards, half circle
+    60.0f, 160.0f, // Speed
+    0.3f, 0.6f, // Life
+    6.0f, 2.0f, // Size
+    {255, 215, 0, 255}, {255, 255, 160, 0},
+    240.0f, 1.5f}; // Gravity, drag
+
+// Red burst in every direction where the player died
+constexpr ParticleEmitter DEATH_BURST = {
+    96, -PI / 2, 2 * PI, // Count, any direction
+    80.0f, 260.0f, // Speed
+    0.4f, 0.9f, // Life
+    8.0f, 2.0f, // Size
+    {200, 30, 30, 255}, {90, 0, 0, 0},
+    480.0f, 2.0f}; // Gravity, drag
+
+// Dust kicked back when a dash starts; aimed at emit time
+constexpr ParticleEmitter DASH_TRAIL = {
+    16, 0.0f, PI / 4, // Count, narrow cone
+    40.0f, 120.0f, // Speed
+    0.15f, 0.3f, // Life
+    5.0f, 1.0f, // Size
+    {235, 235, 235, 200}, {200, 200, 200, 0},
+    0.0f, 4.0f}; // Gravity, drag
+
+} // namespace
+
 /**
  * Game Constructor - Initialize SDL and create window/renderer
  *
@@ -30,11 +69,7 @@ Game::Game(const char *name, const char *playerTexture, int windowWidth,
                    SDL_DestroyRenderer(renderer);
                }),
       playerTexturePath(playerTexture), targetWidth(windowWidth),
-      targetHeight(windowHeight), audioManager(nullptr),
-      font(nullptr, [](TTF_Font *f) {
-        if (f)
-          TTF_CloseFont(f);
-      }) {
+      targetHeight(windowHeight), audioManager(nullptr) {
 
   // Create main game window (windowWidth x windowHeight, centered on screen)
   window.reset(SDL_CreateWindow(
@@ -56,6 +91,19 @@ Game::Game(const char *name, const char *playerTexture, int windowWidth,
                              std::string(SDL_GetError()));
   }
 
+  // A hidden window (headless runs) never draws
+  windowHidden = (windowFlags & SDL_WINDOW_HIDDEN) != 0;
+
+  // Pace frames the way the renderer was created; VSync frames are judged
+  // against the display's refresh rate
+  frameLimiter.setMode((rendererFlags & SDL_RENDERER_PRESENTVSYNC)
+                           ? PacingMode::VSYNC
+                           : PacingMode::UNCAPPED);
+  SDL_DisplayMode displayMode;
+  if (SDL_GetWindowDisplayMode(window.get(), &displayMode) == 0) {
+    frameLimiter.setRefreshRate(displayMode.refresh_rate);
+  }
+
   // Disable integer scaling so content scales continuously with window size
   SDL_RenderSetIntegerScale(renderer.get(), SDL_FALSE);
 
@@ -63,12 +111,149 @@ Game::Game(const char *name, const char *playerTexture, int windowWidth,
   SDL_RenderSetLogicalSize(renderer.get(), targetWidth, targetHeight);
 }
 
+void Game::setPacing(PacingMode mode, int targetFps) {
+  // VSync only blocks in VSYNC mode; a cap is timed by the limiter alone
+  const bool vsync = mode == PacingMode::VSYNC;
+#if SDL_VERSION_ATLEAST(2, 0, 18)
+  if (SDL_RenderSetVSync(renderer.get(), vsync ? 1 : 0) != 0) {
+    std::cerr << "Could not change VSync: " << SDL_GetError() << std::endl;
+  }
+#else
+  SDL_RendererInfo info;
+  if (SDL_GetRendererInfo(renderer.get(), &info) == 0 &&
+      static_cast<bool>(info.flags & SDL_RENDERER_PRESENTVSYNC) != vsync) {
+    std::cerr << "VSync can only be chosen when the renderer is created"
+              << std::endl;
+  }
+#endif
+
+  frameLimiter.setMode(mode, targetFps);
+  std::cout << "Frame pacing: " << FrameLimiter::modeName(mode);
+  if (mode == PacingMode::CAPPED) {
+    std::cout << " (" << frameLimiter.getTargetFps() << " FPS)";
+  }
+  std::cout << std::endl;
+}
+
+void Game::logPacingStats() const {
+  const FrameLimiter::Stats &stats = frameLimiter.getStats();
+  if (stats.frames == 0)
+    return;
+  std::cout << "Frame pacing ["
+            << FrameLimiter::modeName(frameLimiter.getMode())
+            << "]: " << stats.frames << " frames, mean " << stats.meanMs
+            << " ms, stddev " << std::sqrt(stats.varianceMs2) << " ms, worst "
+            << stats.worstMs << " ms, " << stats.missedDeadlines
+            << " missed deadlines" << std::endl;
+}
+
+bool Game::playReplay(const std::string &path, bool fastForward) {
+  Replay loaded;
+  if (!loaded.load(path))
+    return false;
+  replay = std::move(loaded);
+  replaying = true;
+  replayFastForward = fastForward;
+  std::cout << "Playing replay " << path << " (" << replay.tickCount()
+            << " ticks)" << std::endl;
+  return true;
+}
+
 void Game::init() {
   // Initialize high-resolution timer for precise delta time calculation
   perfFreq = SDL_GetPerformanceFrequency();
 
+  // Lets the simulation thread wake an idle main thread
+  snapshotEvent = SDL_RegisterEvents(1);
+
+  // Worker threads for loading and the per-tick entity updates
+  jobSystem = std::make_shared<JobSystem>();
+
+  // Every image texture is loaded through one cache
+  textureCache = std::make_shared<TextureCache>(renderer.get());
+
+  // Frames reused while the game is paused or won
+  frozenWorld = std::make_unique<RenderCache>(renderer.get(), targetWidth,
+                                              targetHeight, false);
+  pauseOverlay = std::make_unique<RenderCache>(renderer.get(), targetWidth,
+                                               targetHeight, true);
+  winOverlay = std::make_unique<RenderCache>(renderer.get(), targetWidth,
+                                             targetHeight, true);
+
+  // Initialize audio manager. The mixer must be open before sounds are
+  // decoded so they are converted to the device format.
+  audioManager = std::make_shared<AudioManager>(std::move(audioBackend));
+  try {
+    audioManager->init();
+  } catch (const std::exception &e) {
+    // No usable audio device: keep playing silently
+    std::cerr << e.what() << " - continuing without audio" << std::endl;
+    audioManager =
+        std::make_shared<AudioManager>(std::make_unique<NullAudioBackend>());
+    audioManager->init();
+  }
+  const bool decodeAudio = audioManager->needsSampleData();
+
+  // Decode every startup asset in parallel on the pool; the map parses on
+  // this thread meanwhile
+  struct SoundSetup {
+    SoundId id;
+    const char *path;
+    int priority;     // Who wins when voices run out
+    int maxInstances; // Overlapping copies allowed
+  };
+  const SoundSetup playerSounds[] = {
+      {PlayerSounds::DEAD_BY_TRAP, PATH_TO_DEAD_BY_TRAP_SOUND, 2, 1},
+      {PlayerSounds::WIN, PATH_TO_WIN_SOUND, 3, 1},
+      {PlayerSounds::JUMP, PATH_TO_JUMP_SOUND, 1, 1},
+      {PlayerSounds::DASH, PATH_TO_DASH_SOUND, 1, 1},
+      {PlayerSounds::COLLECT_COIN, PATH_TO_COLLECT_COIN_SOUND, 0, 3},
+      {PlayerSounds::HIT_BY_ARROW, PATH_TO_HIT_BY_ARROW_SOUND, 2, 2},
+  };
+  AssetLoader assets(jobSystem);
+  assets.loadFont(FONT_PATH, 16);
+  if (decodeAudio) {
+    assets.loadMusic(PATH_TO_MUSIC);
+    for (const auto &sound : playerSounds) {
+      assets.loadSound(sound.id.name, sound.path);
+    }
+  }
+  assets.loadImage(PLAYER_TEXTURE_PATH);
+
+  map = std::make_unique<Map>(DEFAULT_MAP_WIDTH, DEFAULT_MAP_HEIGHT,
+                              DEFAULT_TILE_WIDTH, DEFAULT_TILE_HEIGHT,
+                              MAP_FILE_PATH);
+  map->setJobSystem(jobSystem);
+  map->setTextureCache(textureCache);
+
+  map->init(renderer.get());
+
+  // A replay only reproduces on the world and tick rate it was made with
+  const Uint32 mapHash = Replay::hashResource(MAP_FILE_PATH);
+  if (replaying && (replay.getMapHash() != mapHash ||
+                    replay.getTickRate() != SIMULATION_TICK_RATE)) {
+    std::cerr << "Replay was recorded on a different map or tick rate; "
+                 "ignoring it"
+              << std::endl;
+    replaying = false;
+    replayFastForward = false;
+  }
+  recording = Replay(SIMULATION_TICK_RATE, mapHash);
+
+  // Barrier: everything is decoded before the first frame
+  assets.wait();
+
   // Load default font for text rendering
-  font.reset(TTF_OpenFont(FONT_PATH, 16));
+  using FontPtr = std::unique_ptr<TTF_Font, void (*)(TTF_Font *)>;
+  FontPtr font(nullptr, [](TTF_Font *f) {
+    if (f)
+      TTF_CloseFont(f);
+  });
+  try {
+    font.reset(assets.takeFont(FONT_PATH));
+  } catch (const std::exception &e) {
+    std::cerr << e.what() << std::endl;
+  }
   if (!font) {
     // Try alternative font path
     font.reset(TTF_OpenFont("/System/Library/Fonts/Arial.ttf", 16));
@@ -79,28 +264,46 @@ void Game::init() {
     }
   }
 
-  // Initialize audio manager
-  audioManager = std::make_shared<AudioManager>();
-  audioManager->init();
+  // Rasterize the glyphs once; the font itself isn't needed afterwards
+  if (font) {
+    try {
+      text = std::make_unique<TextRenderer>(renderer.get(), font.get());
+    } catch (const std::exception &e) {
+      std::cerr << e.what() << std::endl;
+    }
+  }
 
-  audioManager->loadMusic(PATH_TO_MUSIC);
+  // Hand decoded audio to the audio manager
+  try {
+    audioManager->setMusic(decodeAudio ? assets.takeMusic(PATH_TO_MUSIC)
+                                       : nullptr);
+  } catch (const std::exception &e) {
+    std::cerr << e.what() << std::endl;
+  }
 
   // Preload all player sounds
-  audioManager->loadSound(PlayerSounds::DEAD_BY_TRAP,
-                          PATH_TO_DEAD_BY_TRAP_SOUND);
-  audioManager->loadSound(PlayerSounds::WIN, PATH_TO_WIN_SOUND);
-  audioManager->loadSound(PlayerSounds::JUMP, PATH_TO_JUMP_SOUND);
-  audioManager->loadSound(PlayerSounds::DASH, PATH_TO_DASH_SOUND);
-  audioManager->loadSound(PlayerSounds::COLLECT_COIN,
-                          PATH_TO_COLLECT_COIN_SOUND);
-  audioManager->loadSound(PlayerSounds::HIT_BY_ARROW,
-                          PATH_TO_HIT_BY_ARROW_SOUND);
+  for (const auto &sound : playerSounds) {
+    try {
+      AssetLoader::Sound decoded;
+      if (decodeAudio)
+        decoded = assets.takeSound(sound.id.name);
+      if (decoded.stream)
+        audioManager->addStreamedSound(sound.id.name, decoded.stream);
+      else
+        audioManager->addSound(sound.id.name, decoded.chunk);
+    } catch (const std::exception &e) {
+      std::cerr << e.what() << std::endl;
+    }
+    audioManager->setSoundParams(sound.id, sound.priority,
+                                 sound.maxInstances);
+  }
 
   PLAY_MUSIC_DEFAULT ? audioManager->playMusic() : []() {};
 
-  // Create player at starting position with texture
-  auto playerTexture =
-      std::make_shared<Texture>(renderer.get(), PLAYER_TEXTURE_PATH);
+  // Create player at starting position with texture. Only the GPU upload
+  // happens here.
+  auto playerTexture = textureCache->load(
+      PLAYER_TEXTURE_PATH, assets.takeImage(PLAYER_TEXTURE_PATH).get());
 
   player = std::make_unique<RectPlayer>(
       SDL_FRect{PLAYER_START_X, PLAYER_START_Y, PLAYER_WIDTH, PLAYER_HEIGHT},
@@ -108,13 +311,12 @@ void Game::init() {
 
   player->init();
   player->setAudioManager(audioManager);
+  player->setWorldBounds(map->getWorldBounds());
 
-  map = std::make_unique<Map>(DEFAULT_MAP_WIDTH, DEFAULT_MAP_HEIGHT,
-                              DEFAULT_TILE_WIDTH, DEFAULT_TILE_HEIGHT,
-                              MAP_FILE_PATH);
-  map->setAudioManager(audioManager);
+  initParticles();
 
-  map->init(renderer.get());
+  // The history starts at the spawn
+  captureRewindState();
 }
 /**
  * Handle SDL events - Process user input and system events
@@ -123,35 +325,131 @@ void Game::init() {
  *
  * Currently handles:
  * - SDL_QUIT: User closes window (sets isRunning = false)
+ * - Window resize, visibility and focus (idle mode)
+ * - Render target / device resets
+ * - Pause toggle and restart after winning (forwarded to the simulation)
  *
  * Future expansion could include:
  * - Key press/release events for more responsive input
- * - Window resize events
  * - Mouse input
  */
 void Game::handleEvents(SDL_Event &e) {
   while (SDL_PollEvent(&e)) {
-    if (e.type == SDL_QUIT) {
-      isRunning = false;
-    } else if (e.type == SDL_WINDOWEVENT &&
-               e.window.event == SDL_WINDOWEVENT_SIZE_CHANGED) {
+    handleEvent(e);
+  }
+}
+
+void Game::handleEvent(const SDL_Event &e) {
+  if (e.type == SDL_QUIT) {
+    isRunning = false;
+    wakeSimulation();
+  } else if (e.type == snapshotEvent) {
+    needsRedraw = true; // Paused, resumed or won
+  } else if (e.type == SDL_WINDOWEVENT) {
+    switch (e.window.event) {
+    case SDL_WINDOWEVENT_SIZE_CHANGED: {
       int w = e.window.data1;
       int h = e.window.data2;
       // Stretch to fill entire window (no letterboxing)
       SDL_RenderSetViewport(renderer.get(), nullptr);
       SDL_RenderSetScale(renderer.get(), static_cast<float>(w) / targetWidth,
                          static_cast<float>(h) / targetHeight);
-    } else if (e.type == SDL_KEYDOWN) {
-      if (e.key.keysym.scancode == KEY_PAUSE && !hasWon) {
-        isPaused = !isPaused; // Toggle pause state (only if not won)
-      } else if ((e.key.keysym.scancode == SDL_SCANCODE_SPACE ||
-                  e.key.keysym.scancode == KEY_JUMP_ALT2) &&
-                 hasWon) {
-        // Reset game when space is pressed after winning
-        resetGame();
+      invalidateRenderCaches();
+      needsRedraw = true;
+      break;
+    }
+    case SDL_WINDOWEVENT_MINIMIZED:
+    case SDL_WINDOWEVENT_HIDDEN:
+      windowHidden = true;
+      break;
+    case SDL_WINDOWEVENT_SHOWN:
+    case SDL_WINDOWEVENT_RESTORED:
+    case SDL_WINDOWEVENT_MAXIMIZED:
+      windowHidden = false;
+      needsRedraw = true;
+      break;
+    case SDL_WINDOWEVENT_EXPOSED:
+      needsRedraw = true; // The window contents were damaged
+      break;
+    case SDL_WINDOWEVENT_FOCUS_GAINED:
+      windowFocused = true;
+      break;
+    case SDL_WINDOWEVENT_FOCUS_LOST:
+      windowFocused = false;
+      break;
+    default:
+      break;
+    }
+    // The world only runs while it can be seen and played
+    const bool active = !windowHidden && windowFocused;
+    if (simulationActive.exchange(active) != active)
+      wakeSimulation();
+  } else if (e.type == SDL_RENDER_TARGETS_RESET) {
+    invalidateRenderCaches(); // Target contents were lost
+    needsRedraw = true;
+  } else if (e.type == SDL_RENDER_DEVICE_RESET) {
+    frozenWorld->release();
+    pauseOverlay->release();
+    winOverlay->release();
+    needsRedraw = true;
+  } else if ((e.type == SDL_KEYDOWN || e.type == SDL_KEYUP) &&
+             !e.key.repeat) {
+    // Gameplay keys go to the simulation with their timestamps
+    if (Uint32 action = InputBuffer::actionFor(e.key.keysym.scancode)) {
+      if (!input.record(action, e.type == SDL_KEYDOWN, e.key.timestamp)) {
+        std::cerr << "Input buffer full, dropping key event" << std::endl;
       }
     }
   }
+
+  if (e.type == SDL_KEYDOWN) {
+    // The simulation decides whether these apply (pause only if not won,
+    // restart only after winning)
+    if (e.key.keysym.scancode == KEY_PAUSE) {
+      sendCommand(GameCommand::TOGGLE_PAUSE);
+    } else if (e.key.keysym.scancode == KEY_CYCLE_PACING && !e.key.repeat) {
+      // Report how the old mode did, then move on to the next one
+      logPacingStats();
+      switch (frameLimiter.getMode()) {
+      case PacingMode::VSYNC:
+        setPacing(PacingMode::CAPPED);
+        break;
+      case PacingMode::CAPPED:
+        setPacing(PacingMode::UNCAPPED);
+        break;
+      case PacingMode::UNCAPPED:
+        setPacing(PacingMode::VSYNC);
+        break;
+      }
+    } else if (e.key.keysym.scancode == SDL_SCANCODE_SPACE ||
+               e.key.keysym.scancode == KEY_JUMP_ALT2) {
+      sendCommand(GameCommand::RESTART);
+    }
+  }
+}
+
+void Game::sendCommand(GameCommand command) {
+  if (!commands.push(command)) {
+    std::cerr << "Command queue full, dropping input" << std::endl;
+    return;
+  }
+  wakeSimulation();
+}
+
+void Game::wakeSimulation() {
+  // Taking the lock orders this wake-up after a concurrent predicate check,
+  // so it can't be lost
+  { std::lock_guard<std::mutex> lock(simulationMutex); }
+  simulationWake.notify_one();
+}
+
+void Game::logInputLatency() const {
+  const InputBuffer::Latency &latency = input.getLatency();
+  if (latency.events == 0)
+    return;
+  std::cout << "Input latency: " << latency.events << " events, mean "
+            << latency.meanMs << " ms, worst " << latency.worstMs << " ms"
+            << std::endl;
 }
 
 /**
@@ -160,7 +458,8 @@ void Game::handleEvents(SDL_Event &e) {
  * @param dt Delta time in seconds since last frame
  *
  * Input System:
- * - Uses SDL_GetKeyboardState for smooth, continuous input
+ * - Reads this tick's InputBuffer frame: held keys plus taps since the
+ *   last tick, so a press shorter than a tick still counts
  * - Horizontal: A/D keys control left/right movement (180 px/s)
  * - Vertical: W/Space for jumping with variable height control
  * - S key for fast-fall when airborne
@@ -172,89 +471,86 @@ void Game::handleEvents(SDL_Event &e) {
  * - Side-aware collision detection for proper platformer feel
  *
  * Collision System:
- * - Projects player movement to detect intersection type
- * - Bottom collisions: land and stop falling
- * - Side collisions: stop horizontal movement, preserve vertical
+ * - TileMover sweeps the tick's displacement along X, then Y, stopping
+ *   flush against solid tiles
+ * - Ground contact grounds the player; no contact means airborne
+ * - Wall contact stops horizontal movement, ceiling contact ends the rise
  */
 void Game::updatePlayerPos(float dt) {
   // Early return if player not initialized or game is paused
   if (!player || isPaused)
     return;
 
-  const Uint8 *keyboardState = SDL_GetKeyboardState(NULL);
-
   // Read input states
-  bool moveLeft =
-      keyboardState[KEY_MOVE_LEFT] || keyboardState[KEY_MOVE_LEFT_ALT];
-  bool moveRight =
-      keyboardState[KEY_MOVE_RIGHT] || keyboardState[KEY_MOVE_RIGHT_ALT];
-  bool jump = keyboardState[KEY_JUMP] || keyboardState[KEY_JUMP_ALT1] ||
-              keyboardState[KEY_JUMP_ALT2];
-  bool fastFall =
-      (keyboardState[KEY_FAST_FALL] || keyboardState[KEY_FAST_FALL_ALT]) &&
-      !player->grounded();
-  bool dash = keyboardState[KEY_DASH] || keyboardState[KEY_DASH_ALT];
-  bool crouch = keyboardState[KEY_CROUCH] && player->grounded() ||
-                keyboardState[KEY_CROUCH_ALT] && player->grounded();
+  bool moveLeft = tickInput.isDown(INPUT_MOVE_LEFT);
+  bool moveRight = tickInput.isDown(INPUT_MOVE_RIGHT);
+  bool jump = tickInput.isDown(INPUT_JUMP);
+  bool fastFall = tickInput.isDown(INPUT_FAST_FALL) && !player->grounded();
+  bool dash = tickInput.isDown(INPUT_DASH);
+  bool crouch = tickInput.isDown(INPUT_CROUCH) && player->grounded();
 
   // Handle movement through the new system
+  const bool wasDashing = player->isDashing();
   player->handleMovement(dt, moveLeft, moveRight, jump, fastFall, dash, crouch);
 
-  // Ground check - check if player is still touching ground by looking slightly
-  // below
-  if (player->grounded()) {
-    SDL_FRect playerBounds = player->getCollisionBounds();
-    SDL_FRect groundCheckBounds = {
-        playerBounds.x,
-        playerBounds.y + playerBounds.h, // Start just below player
-        playerBounds.w,
-        GROUND_CHECK_HEIGHT // Small height to check for ground
-    };
-
-    bool stillOnGround = false;
-
-    // Check against map tiles
-    auto nearbyTiles = map->getTilesInRect(groundCheckBounds);
-    for (auto &tile : nearbyTiles) {
-      if (CollisionSystem::checkAABB(groundCheckBounds,
-                                     tile->getCollisionBounds())) {
-        stillOnGround = true;
-        break;
-      }
-    }
-
-    if (!stillOnGround) {
-      player->setGrounded(false);
-    }
+  // Dust thrown back from the feet when a dash starts
+  if (!wasDashing && player->isDashing()) {
+    const SDL_FRect bounds = player->getCollisionBounds();
+    const float backwards = player->getVel().first > 0.0f ? PI : 0.0f;
+    particles.emit(dashParticles, bounds.x + bounds.w / 2,
+                   bounds.y + bounds.h, backwards);
   }
 
-  // Collision detection
-  // Not Owning
-  std::vector<Collideable *> colliders;
-
-  // Get tiles near the player for efficient collision detection
-  SDL_FRect playerBounds = player->getCollisionBounds();
-  auto nearbyTiles = map->getTilesInRect(playerBounds);
-  for (auto &tile : nearbyTiles) {
-    colliders.push_back(tile.get());
+  // Integrate freely, then sweep the same displacement through the tiles
+  const std::pair<float, float> start = player->getPos();
+  SDL_FRect box = player->getCollisionBounds();
+  const float fromX = box.x;
+  const float fromY = box.y;
+  player->update(dt);
+  const std::pair<float, float> moved = player->getPos();
+  const float dy = moved.second - start.second;
+  Uint8 contacts =
+      TileMover::move(*map, box, moved.first - start.first, dy);
+
+  // A box that didn't move vertically (crouching) presses on nothing, so
+  // probe below it for the ground instead
+  if (dy == 0.0f) {
+    SDL_FRect probe = box;
+    contacts |= TileMover::move(*map, probe, 0.0f, GROUND_CHECK_HEIGHT) &
+                TileMover::GROUND;
   }
+  player->setPos(start.first + (box.x - fromX),
+                 start.second + (box.y - fromY));
 
-  CollisionSystem::resolveCollisions(player.get(), colliders);
+  if (contacts & TileMover::WALL) {
+    player->setVel(0.0f, player->getVel().second);
+  }
+  if (contacts & TileMover::CEILING) {
+    player->applyContact(0.0f, 1.0f);
+  }
+  if (contacts & TileMover::GROUND) {
+    player->applyContact(0.0f, -1.0f);
 
-  // Apply movement update
-  player->update(dt);
+    // Let the tiles underfoot know, so disappearing platforms start to go
+    const SDL_FRect feet = {box.x, box.y + box.h, box.w, GROUND_CHECK_HEIGHT};
+    for (auto &tile : map->getTilesInRect(feet)) {
+      tile->onCollision(player.get(), 0.0f, 1.0f, 0.0f);
+    }
+  } else {
+    player->setGrounded(false);
+  }
 }
 /**
- * Main game loop - Core execution and rendering
+ * Main game loop - Core execution and rendering (main thread)
  *
  * Architecture:
- * 1. High-precision timing using SDL performance counters
- * 2. Input processing and physics updates
- * 3. Render cycle: clear → draw objects → present
+ * 1. Input: poll events, sample held keys for the simulation
+ * 2. Simulation runs on its own thread (simulationLoop())
+ * 3. Render cycle: take the latest snapshot → draw → present
  *
  * Performance:
- * - VSync limits framerate to monitor refresh
- * - Delta time ensures frame-rate independent movement
+ * - Frames are paced by VSync, a FrameLimiter cap, or not at all
+ * - The simulation steps at a fixed rate regardless of the frame rate
  * - Hardware acceleration for smooth rendering
  */
 void Game::run() {
@@ -263,128 +559,475 @@ void Game::run() {
   isRunning = true;
   SDL_Event e;
 
-  // Initialize high-resolution timing
-  Uint64 t0 = SDL_GetPerformanceCounter();
-
   // Initialize game objects (platforms, etc.)
   init();
 
   // Set initial animation frame for IDLE state
   player->animationHandle();
 
+  // The first frame exists before the simulation starts
+  publishSnapshot();
+  simulationThread = std::thread(&Game::simulationLoop, this);
+
   // Main game loop - continues until user quits
+  bool idling = false;
   while (isRunning) {
-    // === TIMING: Calculate frame delta time ===
-    Uint64 t1 = SDL_GetPerformanceCounter();
-    double dt = (double)(t1 - t0) / (double)perfFreq; // Convert to seconds
-    t0 = t1;                                          // Update for next frame
-
-    // === INPUT & PHYSICS: Process input and update game state ===
-    handleEvents(e); // Handle quit events and pause
-
-    // Only update game state if not paused and not won
-    if (!isPaused && !hasWon) {
-      updatePlayerPos(dt); // Handle movement input and physics
-
-      // Update projectiles
-      map->updateProjectiles(dt);
-
-      // Update disappearing platforms
-      map->updateDisappearingPlatforms(dt);
-
-      // Apply layer-based status effects to player
-      if (player) {
-        // Check if player is on slow layer
-        bool onSlowLayer =
-            map->isPlayerOnSlowLayer(player->getCollisionBounds());
-        player->setSlowed(onSlowLayer);
-
-        // Check if player died from trap layer
-        if (map->isPlayerOnTrapLayer(player->getCollisionBounds())) {
-          player->setDead(true);
-          audioManager->playSound(PlayerSounds::DEAD_BY_TRAP);
-        }
-
-        // Handle player death (simple respawn for now)
-        if (player->getDead()) {
-          // Reset player position to start
-          player->setPos(PLAYER_START_X, PLAYER_START_Y);
-          player->setDead(false);
-          // Reset all coins when player dies
-          map->resetCoins();
-        }
+    const bool fresh = snapshots.update();
+    const RenderSnapshot &shown = snapshots.front();
+
+    // === IDLE: nothing on screen moves, so sleep on the event queue ===
+    if (isIdle(shown)) {
+      if (!idling) {
+        idling = true;
+        needsRedraw = true; // Show the state we stopped in
+      }
+      if (SDL_WaitEventTimeout(&e, IDLE_WAIT_TIMEOUT_MS)) {
+        handleEvent(e);
+        handleEvents(e); // Drain whatever else is queued
+      }
+      if ((fresh || needsRedraw) && !windowHidden && isRunning) {
+        renderFrame(shown);
+        needsRedraw = false;
+      }
+      continue;
+    }
+    if (idling) {
+      idling = false;
+      frameLimiter.reset(); // The idle gap isn't a frame
+    }
+
+    // === INPUT: Handle quit events and pause, queue key events ===
+    handleEvents(e);
+
+    // === RENDERING: Draw the latest simulation state ===
+    renderFrame(shown);
+
+    // === PACING: Wait out the frame (capped mode) and time it. Events are
+    // polled while waiting, so input reaches the simulation at its own rate
+    // rather than the frame rate.
+    frameLimiter.endFrame([&]() { handleEvents(e); });
+  }
+
+  stopSimulation();
+  logPacingStats();
+  logInputLatency();
+  if (!recordPath.empty()) {
+    recording.save(recordPath);
+  }
+}
+
+void Game::simulationLoop() {
+  using Clock = std::chrono::steady_clock;
+  const auto tickLength = std::chrono::duration_cast<Clock::duration>(
+      std::chrono::duration<double>(1.0 / SIMULATION_TICK_RATE));
+  const float dt = 1.0f / SIMULATION_TICK_RATE;
+
+  try {
+    auto nextTick = Clock::now();
+    while (isRunning) {
+      if (applyCommands())
+        publishSnapshot();
+
+      // === REPLAY BENCHMARK: ticks back to back, as fast as they run ===
+      if (replaying && replayFastForward && !simulationFrozen()) {
+        simulate(dt);
+        publishSnapshot();
+        continue;
       }
 
-      // Check collisions between player and projectiles
-      if (player) {
-        for (auto &projectile : map->getProjectiles()) {
-          if (CollisionSystem::checkAABB(player->getCollisionBounds(),
-                                         projectile->getCollisionBounds())) {
-            // Check if it's a coin before collision to track collection
-            bool wasCoin = (projectile->getProjectileType() ==
-                            Projectile::ProjectileType::COIN);
-
-            // Handle collision directly instead of using private method
-            float normalX, normalY, penetration;
-            CollisionSystem::computeCollisionInfo(
-                player->getCollisionBounds(), projectile->getCollisionBounds(),
-                normalX, normalY, penetration);
-            // Call collision callbacks (projectile handles collection/damage
-            // logic)
-            player->onCollision(projectile.get(), normalX, normalY,
-                                penetration);
-            projectile->onCollision(player.get(), -normalX, -normalY,
-                                    penetration);
-
-            // If a coin was collected, increment counter
-            if (wasCoin && projectile->shouldBeRemoved()) {
-              map->collectCoin();
-            }
-          }
-        }
+      // === IDLE: paused, won or inactive window ===
+      if (simulationFrozen() || !simulationActive) {
+        input.consume(); // Keep held keys current; taps don't carry over
+        audioManager->update(); // Music fades still need servicing
+        std::unique_lock<std::mutex> lock(simulationMutex);
+        simulationWake.wait_for(
+            lock, std::chrono::milliseconds(IDLE_WAIT_TIMEOUT_MS), [this]() {
+              return !isRunning || !commands.empty() ||
+                     (simulationActive && !simulationFrozen());
+            });
+
+        // Resume from a fresh baseline instead of catching up the idle time
+        nextTick = Clock::now();
+        continue;
       }
 
-      // Check for win condition
-      if (map->areAllCoinsCollected() && !hasWon) {
-        hasWon = true;
-        audioManager->stopMusic(); // Stop background music
-        audioManager->playSound(PlayerSounds::WIN,
-                                -1); // Play win sound on loop
-        std::cout << "You collected all coins and won!" << std::endl;
+      // Run every tick that is due; after a long stall drop the backlog
+      // instead of fast-forwarding through it
+      int ticks = 0;
+      while (Clock::now() >= nextTick && ticks < SIMULATION_MAX_CATCHUP_TICKS &&
+             !simulationFrozen()) {
+        simulate(dt);
+        nextTick += tickLength;
+        ++ticks;
       }
+      if (ticks == SIMULATION_MAX_CATCHUP_TICKS)
+        nextTick = Clock::now();
+      if (ticks > 0)
+        publishSnapshot();
 
-      // Remove dead projectiles and disappeared platforms
-      map->removeDeadProjectiles();
-      map->removeDisappearedPlatforms();
+      std::this_thread::sleep_until(nextTick);
     }
+  } catch (const std::exception &ex) {
+    std::cerr << "Simulation stopped: " << ex.what() << std::endl;
+    isRunning = false;
+  }
+}
 
-    // === RENDERING: Draw frame to screen ===
-    // Clear screen to white background
-    SDL_SetRenderDrawColor(renderer.get(), ALPHA_OPAQUE, ALPHA_OPAQUE,
-                           ALPHA_OPAQUE, ALPHA_OPAQUE);
-    SDL_RenderClear(renderer.get());
+void Game::simulate(float dt) {
+  ++simulationTick;
+
+  // Every key event since the previous tick, each edge exactly once
+  tickInput = input.consume();
+
+  // Never read replay state past its end
+  if (replaying && replayTick >= replay.tickCount())
+    finishReplay();
+
+  // A replay overrides the keyboard (and restarts when the recording did)
+  if (replaying) {
+    const Uint16 recorded = replay.inputAt(replayTick);
+    if (replayTick == 0)
+      replayStarted = SDL_GetPerformanceCounter();
+    if (recorded & Replay::RESTART)
+      resetGame();
+    pendingReplayFlags |= recorded & ~Replay::INPUT_MASK;
+    tickInput = InputBuffer::Frame();
+    tickInput.held = recorded & Replay::INPUT_MASK;
+  }
+  const Uint16 tickBits =
+      static_cast<Uint16>((tickInput.held | tickInput.pressed) &
+                          Replay::INPUT_MASK);
+
+  // Holding rewind steps back through the history instead of forwards
+  const bool rewound = tickInput.isDown(INPUT_REWIND) &&
+                       rewindWorld(REWIND_TICKS_PER_TICK);
+  if (!rewound) {
+    advanceWorld(dt);
+    captureRewindState();
+  }
 
-    // Draw map tiles (this replaces individual platform rendering)
-    map->render(renderer.get(), dt);
+  replayTickDone(tickBits);
 
-    // Draw player sprite
-    if (player) {
-      player->renderAnimation(renderer.get(), dt);
+  // Start the sounds requested this tick, heard from the player
+  if (player) {
+    SDL_FRect listener = player->getCollisionBounds();
+    audioManager->setListener(listener.x + listener.w / 2,
+                              listener.y + listener.h / 2);
+  }
+  audioManager->update();
+}
+
+void Game::advanceWorld(float dt) {
+  // Stream infinite-map chunks around the player before any tile queries
+  if (player) {
+    map->updateStreaming(player->getCollisionBounds());
+  }
+
+  updatePlayerPos(dt); // Handle movement input and physics
+
+  // Move arrows and animate coins and animated tiles
+  map->updateEntities(dt);
+  map->updateTileAnimations(dt);
+  particles.update(dt);
+
+  // Update disappearing platforms
+  map->updateDisappearingPlatforms(dt);
+
+  // Apply layer-based status effects to player
+  if (player) {
+    // Check if player is on slow layer
+    bool onSlowLayer = map->isPlayerOnSlowLayer(player->getCollisionBounds());
+    player->setSlowed(onSlowLayer);
+
+    // Check if player died from trap layer
+    if (map->isPlayerOnTrapLayer(player->getCollisionBounds())) {
+      player->setDead(true);
+      audioManager->playSound(PlayerSounds::DEAD_BY_TRAP);
+    }
+
+    // Handle player death (simple respawn for now)
+    if (player->getDead()) {
+      const SDL_FRect bounds = player->getCollisionBounds();
+      particles.emit(deathParticles, bounds.x + bounds.w / 2,
+                     bounds.y + bounds.h / 2);
+      // Reset player position to start
+      player->setPos(PLAYER_START_X, PLAYER_START_Y);
+      player->setDead(false);
+      // Reset all coins when player dies
+      map->resetCoins();
+    }
+  }
+
+  // Check collisions between player and coins/arrows
+  if (player) {
+    collideEntities();
+  }
+
+  // Check for win condition
+  if (map->areAllCoinsCollected() && !hasWon) {
+    hasWon = true;
+    // Loop the win music; being a streamed sound, it fades out the
+    // background music first
+    audioManager->playSound(PlayerSounds::WIN, -1);
+    std::cout << "You collected all coins and won!" << std::endl;
+  }
+
+  // Remove disappeared platforms
+  map->removeDisappearedPlatforms();
+
+  // Advance the player's animation
+  if (player) {
+    player->updateAnimation(dt);
+  }
+}
+
+void Game::initParticles() {
+  // Plain white: each particle is tinted by its vertex color. All-ones is
+  // opaque white in any 32-bit format.
+  using SurfacePtr = std::unique_ptr<SDL_Surface, void (*)(SDL_Surface *)>;
+  SurfacePtr white(SDL_CreateRGBSurfaceWithFormat(
+                       0, PARTICLE_TEXTURE_SIZE, PARTICLE_TEXTURE_SIZE, 32,
+                       SDL_PIXELFORMAT_RGBA32),
+                   SDL_FreeSurface);
+  try {
+    if (!white || SDL_FillRect(white.get(), nullptr, 0xFFFFFFFFu) != 0)
+      throw std::runtime_error(SDL_GetError());
+    particleTexture =
+        std::make_unique<Texture>(renderer.get(), white.get(), "particle");
+  } catch (const std::exception &e) {
+    // Particles still simulate; they just aren't drawn
+    std::cerr << "Failed to create particle texture: " << e.what()
+              << std::endl;
+  }
+
+  SDL_Texture *texture = particleTexture ? particleTexture->get() : nullptr;
+  const SDL_Rect src = {0, 0, PARTICLE_TEXTURE_SIZE, PARTICLE_TEXTURE_SIZE};
+  coinParticles =
+      particles.addPool(COIN_BURST, texture, src, PARTICLE_POOL_CAPACITY);
+  deathParticles =
+      particles.addPool(DEATH_BURST, texture, src, PARTICLE_POOL_CAPACITY);
+  dashParticles =
+      particles.addPool(DASH_TRAIL, texture, src, PARTICLE_POOL_CAPACITY);
+}
+
+void Game::captureRewindState() {
+  if (!player || !map->canSaveState())
+    return;
+  rewindState.clear();
+  StateWriter out(rewindState);
+  player->saveState(out);
+  map->saveState(out);
+  rewindHistory.push(rewindState);
+}
+
+bool Game::rewindWorld(size_t ticks) {
+  if (!player || rewindHistory.size() == 0)
+    return false;
+  // The newest entry is the current state; at the oldest one, stay there
+  // rather than advancing and rewinding again every tick
+  if (rewindHistory.size() < 2)
+    return true;
+  rewindHistory.drop(std::min(ticks, rewindHistory.size() - 1));
+  if (!rewindHistory.restore(0, rewindState))
+    return false;
+
+  StateReader in(rewindState);
+  player->loadState(in);
+  map->loadState(in);
+  if (!in.ok()) {
+    std::cerr << "Rewind state doesn't match the world; history cleared"
+              << std::endl;
+    rewindHistory.clear();
+  }
+  return true;
+}
+
+void Game::collideEntities() {
+  EntityRegistry &entities = map->getEntities();
+
+  // Parallel phase: pure overlap tests. Contacts change velocities, never
+  // the player's bounds, so testing every entity against the same bounds
+  // matches a serial pass.
+  EntitySystems::touchPlayer(entities, player->getCollisionBounds(),
+                             entityContacts, jobSystem.get());
+
+  // Serial phase: effects that cross entities, in collider order
+  for (size_t i = 0; i < entityContacts.size(); ++i) {
+    const EntitySystems::Contact &contact = entityContacts[i];
+    if (!contact.hit)
+      continue;
+    const Entity entity = entities.colliders.entityAt(i);
+    player->applyContact(contact.normalX, contact.normalY);
+
+    const SDL_FRect bounds = EntitySystems::colliderBounds(entities, entity);
+    const float centerX = bounds.x + bounds.w / 2;
+    const float centerY = bounds.y + bounds.h / 2;
+    if (entities.pickups.has(entity)) {
+      // Coin collected: hidden until the coins are reset
+      entities.setActive(entity, false);
+      map->collectCoin();
+      audioManager->playSoundAt(PlayerSounds::COLLECT_COIN, centerX,
+                                centerY);
+      particles.emit(coinParticles, centerX, centerY);
+    } else if (entities.hazards.has(entity)) {
+      player->setDead(true);
+      audioManager->playSoundAt(PlayerSounds::HIT_BY_ARROW, centerX,
+                                centerY);
     }
+  }
+}
+
+bool Game::simulationFrozen() const {
+  if (isPaused)
+    return true;
+  if (!hasWon)
+    return false;
+  // The recording went on after this win: the next tick restarts
+  return !(replaying && replayTick < replay.tickCount() &&
+           (replay.inputAt(replayTick) & Replay::RESTART));
+}
+
+Uint32 Game::stateHash() {
+  Uint32 hash = Replay::HASH_SEED;
+  if (player) {
+    const std::pair<float, float> position = player->getPos();
+    hash = Replay::hash(&position.first, sizeof(float), hash);
+    hash = Replay::hash(&position.second, sizeof(float), hash);
+  }
+  const int coins = map->getCollectedCoins();
+  hash = Replay::hash(&coins, sizeof(coins), hash);
+  const EntityRegistry &entities = map->getEntities();
+  for (size_t i = 0; i < entities.transforms.size(); ++i) {
+    if (!entities.isActive(entities.transforms.entityAt(i)))
+      continue;
+    const Component::Transform &transform = entities.transforms[i];
+    hash = Replay::hash(&transform.x, sizeof(float), hash);
+    hash = Replay::hash(&transform.y, sizeof(float), hash);
+  }
+  return hash;
+}
+
+void Game::replayTickDone(Uint16 input) {
+  const bool recordingTicks = !recordPath.empty();
+  if (!recordingTicks && !replaying)
+    return;
+
+  const Uint32 hash = stateHash();
+  if (recordingTicks) {
+    recording.record(input | pendingReplayFlags, hash);
+  }
+  pendingReplayFlags = 0;
 
-    // Draw pause menu if paused
-    if (isPaused && !hasWon) {
-      renderPauseMenu();
+  if (replaying) {
+    if (hash != replay.hashAt(replayTick)) {
+      if (replayDesyncs == 0) {
+        std::cerr << "Replay desync at tick " << replayTick << std::endl;
+      }
+      ++replayDesyncs;
+    }
+    if (++replayTick >= replay.tickCount()) {
+      finishReplay();
     }
+  }
+}
+
+void Game::finishReplay() {
+  const double seconds =
+      static_cast<double>(SDL_GetPerformanceCounter() - replayStarted) /
+      perfFreq;
+  std::cout << "Replay finished: " << replayTick << " ticks in " << seconds
+            << " s (" << (seconds > 0.0 ? replayTick / seconds : 0.0)
+            << " ticks/s), " << replayDesyncs << " desynced ticks"
+            << std::endl;
+
+  replaying = false;
+  if (replayFastForward) {
+    isRunning = false; // Benchmark run: done
+    SDL_Event quit;
+    SDL_zero(quit);
+    quit.type = SDL_QUIT;
+    SDL_PushEvent(&quit);
+  }
+}
 
-    // Draw win screen if won
-    if (hasWon) {
-      renderWinScreen();
+bool Game::applyCommands() {
+  const bool wasPaused = isPaused, wasWon = hasWon;
+  GameCommand command;
+  while (commands.pop(command)) {
+    switch (command) {
+    case GameCommand::TOGGLE_PAUSE:
+      if (!hasWon) {
+        isPaused = !isPaused; // Toggle pause state (only if not won)
+        pendingReplayFlags ^= Replay::PAUSE;
+      }
+      break;
+    case GameCommand::RESTART:
+      // Reset game when space is pressed after winning. A replay restarts
+      // on its own.
+      if (hasWon && !replaying) {
+        resetGame();
+        pendingReplayFlags |= Replay::RESTART;
+      }
+      break;
     }
+  }
+  return isPaused != wasPaused || hasWon != wasWon;
+}
+
+void Game::publishSnapshot() {
+  RenderSnapshot &snapshot = snapshots.back();
+  snapshot.clear();
+  map->render(snapshot);
+  if (player) {
+    player->render(snapshot);
+  }
+  particles.render(snapshot);
+  snapshot.paused = isPaused;
+  snapshot.won = hasWon;
+  snapshot.tick = simulationTick;
+  snapshots.publish();
+
+  // An idle main thread only wakes for events: tell it the state changed
+  if (isPaused != publishedPaused || hasWon != publishedWon) {
+    publishedPaused = isPaused;
+    publishedWon = hasWon;
+    SDL_Event event;
+    SDL_zero(event);
+    event.type = snapshotEvent;
+    SDL_PushEvent(&event);
+  }
+}
+
+void Game::stopSimulation() {
+  isRunning = false;
+  wakeSimulation();
+  if (simulationThread.joinable()) {
+    simulationThread.join();
+  }
+}
+
+void Game::renderFrame(const RenderSnapshot &snapshot) {
+  if (!snapshot.paused && !snapshot.won) {
+    frozenWorld->invalidate(); // Capture afresh on the next pause
+    renderWorld(snapshot);
+  } else {
+    // The world is frozen: replay the frame captured when it stopped
+    SDL_RenderClear(renderer.get());
+    frozenWorld->render([&]() { renderWorld(snapshot); });
+  }
+
+  // Draw pause menu if paused
+  if (snapshot.paused && !snapshot.won) {
+    pauseOverlay->render([this]() { renderPauseMenu(); });
+  }
 
-    // Present completed frame
-    SDL_RenderPresent(renderer.get());
+  // Draw win screen if won
+  if (snapshot.won) {
+    winOverlay->render([this]() { renderWinScreen(); });
   }
+
+  // Present completed frame
+  SDL_RenderPresent(renderer.get());
 }
 
 /**
@@ -399,26 +1042,27 @@ void Game::run() {
  * This ensures proper resource deallocation and prevents memory leaks
  */
 Game::~Game() {
-  // No manual cleanup needed - unique_ptr handles player cleanup automatically
+  // The simulation thread uses everything below; stop it first
+  stopSimulation();
 }
 
 /**
- * Render text to a texture
+ * Draw the game world: background, map tiles and player
  */
-SDL_Texture *Game::renderText(const char *text, SDL_Color color) {
-  if (!font) {
-    return nullptr; // No font available
-  }
-
-  SDL_Surface *surface = TTF_RenderText_Solid(font.get(), text, color);
-  if (!surface) {
-    return nullptr;
-  }
-
-  SDL_Texture *texture = SDL_CreateTextureFromSurface(renderer.get(), surface);
-  SDL_FreeSurface(surface);
+void Game::renderWorld(const RenderSnapshot &snapshot) {
+  // Clear screen to white background
+  SDL_SetRenderDrawColor(renderer.get(), ALPHA_OPAQUE, ALPHA_OPAQUE,
+                         ALPHA_OPAQUE, ALPHA_OPAQUE);
+  SDL_RenderClear(renderer.get());
+
+  // Draw map tiles and the player, as the simulation last saw them
+  snapshot.draw(renderer.get());
+}
 
-  return texture;
+void Game::invalidateRenderCaches() {
+  frozenWorld->invalidate();
+  pauseOverlay->invalidate();
+  winOverlay->invalidate();
 }
 
 /**
@@ -444,8 +1088,7 @@ void Game::renderPauseMenu() {
   SDL_RenderDrawRect(renderer.get(), &menuRect);
 
   // If we have a font, render actual text
-  if (font) {
-    SDL_Color white = {255, 255, 255, 255};
+  if (text) {
     SDL_Color black = {0, 0, 0, 255};
     SDL_Color orange = {255, 165, 0, 255};
 
@@ -453,26 +1096,12 @@ void Game::renderPauseMenu() {
     int centerX = menuRect.x + menuRect.w / 2;
 
     // Render "GAME PAUSED" title
-    SDL_Texture *titleTexture = renderText("GAME PAUSED", black);
-    if (titleTexture) {
-      int w, h;
-      SDL_QueryTexture(titleTexture, NULL, NULL, &w, &h);
-      SDL_Rect titleRect = {centerX - w / 2, currentY, w, h};
-      SDL_RenderCopy(renderer.get(), titleTexture, NULL, &titleRect);
-      SDL_DestroyTexture(titleTexture);
-      currentY += h + 20;
-    }
+    currentY += text->drawCentered("GAME PAUSED", centerX, currentY, black).h +
+                20;
 
     // Render "HOW TO PLAY:" header
-    SDL_Texture *howToPlayTexture = renderText("HOW TO PLAY:", black);
-    if (howToPlayTexture) {
-      int w, h;
-      SDL_QueryTexture(howToPlayTexture, NULL, NULL, &w, &h);
-      SDL_Rect howToRect = {menuRect.x + 20, currentY, w, h};
-      SDL_RenderCopy(renderer.get(), howToPlayTexture, NULL, &howToRect);
-      SDL_DestroyTexture(howToPlayTexture);
-      currentY += h + 10;
-    }
+    currentY +=
+        text->draw("HOW TO PLAY:", menuRect.x + 20, currentY, black).h + 10;
 
     // Render control instructions
     const char *controls[] = {"A/D or Arrow Keys: Move Left/Right",
@@ -480,40 +1109,23 @@ void Game::renderPauseMenu() {
                               "Ctrl: Crouch"};
 
     for (int i = 0; i < 5; i++) {
-      SDL_Texture *controlTexture = renderText(controls[i], black);
-      if (controlTexture) {
-        int w, h;
-        SDL_QueryTexture(controlTexture, NULL, NULL, &w, &h);
-        SDL_Rect controlRect = {menuRect.x + 30, currentY, w, h};
-        SDL_RenderCopy(renderer.get(), controlTexture, NULL, &controlRect);
-        SDL_DestroyTexture(controlTexture);
-        currentY += h + 5;
-      }
+      currentY +=
+          text->draw(controls[i], menuRect.x + 30, currentY, black).h + 5;
     }
 
     currentY += 15;
 
     // Render objective
-    SDL_Texture *objectiveTexture =
-        renderText("COLLECT ALL BANANAS TO WIN!", orange);
-    if (objectiveTexture) {
-      int w, h;
-      SDL_QueryTexture(objectiveTexture, NULL, NULL, &w, &h);
-      SDL_Rect objectiveRect = {centerX - w / 2, currentY, w, h};
-      SDL_RenderCopy(renderer.get(), objectiveTexture, NULL, &objectiveRect);
-      SDL_DestroyTexture(objectiveTexture);
-      currentY += h + 15;
-    }
+    currentY += text->drawCentered("COLLECT ALL BANANAS TO WIN!", centerX,
+                                   currentY, orange)
+                    .h +
+                15;
 
     // Render resume instruction
-    SDL_Texture *resumeTexture = renderText("Press ESC to resume", black);
-    if (resumeTexture) {
-      int w, h;
-      SDL_QueryTexture(resumeTexture, NULL, NULL, &w, &h);
-      SDL_Rect resumeRect = {centerX - w / 2, currentY, w, h};
-      SDL_RenderCopy(renderer.get(), resumeTexture, NULL, &resumeRect);
-      SDL_DestroyTexture(resumeTexture);
-    }
+    text->drawCentered("Press ESC to resume", centerX, currentY, black);
+
+    // All of the menu's text in one draw call
+    text->flush();
   } else {
     // Fallback to rectangles if no font is available
     // Title area (darker gray)
@@ -603,49 +1215,28 @@ void Game::renderWinScreen() {
   SDL_SetRenderDrawColor(renderer.get(), 218, 165, 32, 255); // Dark goldenrod
   SDL_RenderDrawRect(renderer.get(), &winRect);
 
-  if (font) {
+  if (text) {
     SDL_Color black = {0, 0, 0, 255};
     SDL_Color darkBlue = {0, 0, 139, 255};
 
     int centerX = targetWidth / 2;
     int currentY = winRect.y + 30;
 
-    // Render some message title (large)
-    SDL_Texture *messageTexture = renderText("winMessage!", black);
-    if (messageTexture) {
-      int w, h;
-      SDL_QueryTexture(messageTexture, NULL, NULL, &w, &h);
-      // Make it bigger by scaling
-      w *= 3;
-      h *= 3;
-      SDL_Rect messageRect = {centerX - w / 2, currentY, w, h};
-      SDL_RenderCopy(renderer.get(), messageTexture, NULL, &messageRect);
-      SDL_DestroyTexture(messageTexture);
-      currentY += h + 20;
-    }
+    // Render some message title (large: scaled 3x)
+    currentY +=
+        text->drawCentered("winMessage!", centerX, currentY, black, 3.0f).h +
+        20;
 
     // Render "You collected all bananas!"
-    SDL_Texture *victoryTexture =
-        renderText("You collected all bananas!", darkBlue);
-    if (victoryTexture) {
-      int w, h;
-      SDL_QueryTexture(victoryTexture, NULL, NULL, &w, &h);
-      SDL_Rect victoryRect = {centerX - w / 2, currentY, w, h};
-      SDL_RenderCopy(renderer.get(), victoryTexture, NULL, &victoryRect);
-      SDL_DestroyTexture(victoryTexture);
-      currentY += h + 15;
-    }
+    currentY += text->drawCentered("You collected all bananas!", centerX,
+                                   currentY, darkBlue)
+                    .h +
+                15;
 
     // Render "Press SPACE to play again"
-    SDL_Texture *playAgainTexture =
-        renderText("Press SPACE to play again", black);
-    if (playAgainTexture) {
-      int w, h;
-      SDL_QueryTexture(playAgainTexture, NULL, NULL, &w, &h);
-      SDL_Rect playAgainRect = {centerX - w / 2, currentY, w, h};
-      SDL_RenderCopy(renderer.get(), playAgainTexture, NULL, &playAgainRect);
-      SDL_DestroyTexture(playAgainTexture);
-    }
+    text->drawCentered("Press SPACE to play again", centerX, currentY, black);
+
+    text->flush();
   } else {
     // Fallback to rectangles if no font
     // Large win message from earlier representation (big golden rectangle)
@@ -687,10 +1278,18 @@ void Game::resetGame() {
   if (map) {
     map->resetCoins();
   }
+  particles.clear();
+
+  // A new run can't rewind into the previous one
+  rewindHistory.clear();
+  captureRewindState();
 
-  // Stop win sound and restart background music
-  audioManager->stopAll();
+  // Stop sound effects and fade from the win music back to the background
+  // music
+  audioManager->stopAllSounds();
   if (PLAY_MUSIC_DEFAULT) {
-    audioManager->playMusic();
+    audioManager->playMusic(-1, AUDIO_CROSSFADE_MS);
+  } else {
+    audioManager->stopMusic();
   }
 }
@@ -0,0 +1,79 @@
+#include "../include/input_buffer.h"
+#include "../include/config.h"
+#include <algorithm>
+
+InputBuffer::InputBuffer() : frequency(SDL_GetPerformanceFrequency()) {}
+
+Uint32 InputBuffer::actionFor(SDL_Scancode key) {
+  switch (key) {
+  case KEY_MOVE_LEFT:
+  case KEY_MOVE_LEFT_ALT:
+    return INPUT_MOVE_LEFT;
+  case KEY_MOVE_RIGHT:
+  case KEY_MOVE_RIGHT_ALT:
+    return INPUT_MOVE_RIGHT;
+  case KEY_JUMP:
+  case KEY_JUMP_ALT1:
+  case KEY_JUMP_ALT2:
+    return INPUT_JUMP;
+  case KEY_FAST_FALL:
+  case KEY_FAST_FALL_ALT:
+    return INPUT_FAST_FALL;
+  case KEY_DASH:
+  case KEY_DASH_ALT:
+    return INPUT_DASH;
+  case KEY_CROUCH:
+  case KEY_CROUCH_ALT:
+    return INPUT_CROUCH;
+  case KEY_REWIND:
+    return INPUT_REWIND;
+  default:
+    return 0;
+  }
+}
+
+bool InputBuffer::record(Uint32 action, bool pressed, Uint32 sdlTimestamp) {
+  // Move the event's millisecond timestamp onto the performance counter by
+  // subtracting how long ago it happened
+  const Uint64 now = SDL_GetPerformanceCounter();
+  const Uint64 age =
+      static_cast<Uint64>(SDL_GetTicks() - sdlTimestamp) * frequency / 1000;
+  return events.push(Event{action, pressed, now - std::min(age, now)});
+}
+
+InputBuffer::Frame InputBuffer::consume() {
+  Frame frame;
+  const Uint64 now = SDL_GetPerformanceCounter();
+
+  Event event;
+  while (events.pop(event)) {
+    for (int bit = 0; bit < 32; ++bit) {
+      const Uint32 action = 1u << bit;
+      if (!(event.action & action))
+        continue;
+      if (event.pressed) {
+        ++keysDown[bit];
+        held |= action;
+        frame.pressed |= action;
+      } else {
+        // A release without a recorded press (dropped event) counts as 0
+        keysDown[bit] = keysDown[bit] > 0 ? keysDown[bit] - 1 : 0;
+        if (keysDown[bit] == 0) {
+          held &= ~action;
+          frame.released |= action;
+        }
+      }
+    }
+
+    const double ms =
+        static_cast<double>(now - std::min(event.time, now)) * 1000.0 /
+        frequency;
+    ++latency.events;
+    latency.lastMs = ms;
+    latency.meanMs += (ms - latency.meanMs) / latency.events;
+    latency.worstMs = std::max(latency.worstMs, ms);
+  }
+
+  frame.held = held;
+  return frame;
+}
@@ -0,0 +1,158 @@
+#include "../include/job_system.h"
+#include <algorithm>
+
+namespace {
+
+// Which system and deque the current thread works for, if any
+thread_local const JobSystem *currentSystem = nullptr;
+thread_local size_t currentIndex = 0;
+
+} // namespace
+
+JobSystem::JobSystem(size_t threadCount) {
+  if (threadCount == 0) {
+    // The thread calling parallelFor() is the last core
+    threadCount = std::max(1u, std::thread::hardware_concurrency()) - 1;
+  }
+
+  for (size_t i = 0; i <= threadCount; ++i) {
+    queues.push_back(std::make_unique<WorkQueue>());
+  }
+  workers.reserve(threadCount);
+  for (size_t i = 0; i < threadCount; ++i) {
+    workers.emplace_back([this, i]() { workerLoop(i); });
+  }
+}
+
+JobSystem::~JobSystem() {
+  {
+    std::lock_guard<std::mutex> lock(sleepMutex);
+    stopping = true;
+  }
+  workAvailable.notify_all();
+
+  for (auto &worker : workers) {
+    if (worker.joinable()) {
+      worker.join();
+    }
+  }
+}
+
+void JobSystem::run(Loop &loop, size_t count) {
+  const size_t queue = currentQueue();
+  loop.pending.store(1, std::memory_order_relaxed);
+  execute(queue, Job{&loop, 0, count, nullptr});
+
+  // Help out (possibly with other loops' jobs) until every piece is done
+  while (loop.pending.load(std::memory_order_acquire) != 0) {
+    Job job;
+    if (findJob(queue, job)) {
+      execute(queue, job);
+    } else {
+      std::this_thread::yield(); // The rest is running elsewhere
+    }
+  }
+
+  if (loop.error) {
+    std::rethrow_exception(loop.error);
+  }
+}
+
+void JobSystem::workerLoop(size_t index) {
+  currentSystem = this;
+  currentIndex = index;
+
+  while (true) {
+    Job job;
+    if (findJob(index, job)) {
+      execute(index, job);
+      continue;
+    }
+
+    std::unique_lock<std::mutex> lock(sleepMutex);
+    workAvailable.wait(lock, [this]() {
+      return stopping || queuedJobs.load(std::memory_order_acquire) > 0;
+    });
+    // Drain submitted jobs before exiting so no future is left unsatisfied
+    if (stopping && queuedJobs.load(std::memory_order_acquire) == 0) {
+      return;
+    }
+  }
+}
+
+size_t JobSystem::currentQueue() const {
+  // Threads outside the system share the last deque
+  return currentSystem == this ? currentIndex : workers.size();
+}
+
+void JobSystem::push(size_t queue, const Job &job) {
+  {
+    std::lock_guard<std::mutex> lock(queues[queue]->mutex);
+    queues[queue]->jobs.push_back(job);
+  }
+  queuedJobs.fetch_add(1, std::memory_order_release);
+
+  // Taking the lock orders this after a worker's predicate check, so the
+  // wake-up can't be lost
+  { std::lock_guard<std::mutex> lock(sleepMutex); }
+  workAvailable.notify_one();
+}
+
+bool JobSystem::pop(size_t queue, Job &job) {
+  std::lock_guard<std::mutex> lock(queues[queue]->mutex);
+  auto &jobs = queues[queue]->jobs;
+  if (jobs.empty())
+    return false;
+  job = jobs.back(); // Newest: the smallest piece, still warm in cache
+  jobs.pop_back();
+  queuedJobs.fetch_sub(1, std::memory_order_relaxed);
+  return true;
+}
+
+bool JobSystem::steal(size_t thief, Job &job) {
+  for (size_t offset = 1; offset < queues.size(); ++offset) {
+    WorkQueue &victim = *queues[(thief + offset) % queues.size()];
+    std::lock_guard<std::mutex> lock(victim.mutex);
+    if (victim.jobs.empty())
+      continue;
+    job = victim.jobs.front(); // Oldest: the largest piece left
+    victim.jobs.pop_front();
+    queuedJobs.fetch_sub(1, std::memory_order_relaxed);
+    return true;
+  }
+  return false;
+}
+
+bool JobSystem::findJob(size_t queue, Job &job) {
+  return pop(queue, job) || steal(queue, job);
+}
+
+void JobSystem::execute(size_t queue, Job job) {
+  if (job.task) {
+    // The packaged task stores any exception in its future
+    std::unique_ptr<std::function<void()>> task(job.task);
+    (*task)();
+    return;
+  }
+
+  Loop &loop = *job.loop;
+
+  // Keep the lower half, offer the upper half, until the piece is small
+  while (job.end - job.begin > loop.batchSize) {
+    const size_t middle = job.begin + (job.end - job.begin) / 2;
+    loop.pending.fetch_add(1, std::memory_order_relaxed);
+    push(queue, Job{&loop, middle, job.end, nullptr});
+    job.end = middle;
+  }
+
+  try {
+    loop.invoke(loop.body, job.begin, job.end);
+  } catch (...) {
+    std::lock_guard<std::mutex> lock(loop.errorMutex);
+    if (!loop.error)
+      loop.error = std::current_exception();
+  }
+
+  // Last touch of the loop: the caller may return as soon as this hits 0
+  loop.pending.fetch_sub(1, std::memory_order_acq_rel);
+}
@@ -1,5 +1,6 @@
 #include "../include/layer.h"
 #include "../include/config.h"
+#include "../include/tile_animator.h"
 #include <algorithm>
 #include <cmath>
 #include <iostream>
@@ -12,28 +13,37 @@ Layer::Layer(const std::string &name, int width, int height, int tileSizeW,
 }
 
 void Layer::setTile(int x, int y, std::shared_ptr<Platform> tile) {
-  if (!inBounds(x, y))
-    return;
-  tiles[getIndex(x, y)] = std::move(tile);
+  if (auto slot = tileSlot(x, y))
+    *slot = std::move(tile);
 }
 
 std::shared_ptr<Platform> Layer::getTile(int x, int y) const {
-  if (!inBounds(x, y))
-    return nullptr;
-  return tiles[getIndex(x, y)];
+  auto slot = tileSlot(x, y);
+  return slot ? *slot : nullptr;
+}
+
+const Platform *Layer::tileAt(int x, int y) const {
+  auto slot = tileSlot(x, y);
+  return slot ? slot->get() : nullptr;
 }
 
 void Layer::removeTile(int x, int y) {
-  if (!inBounds(x, y))
-    return;
-  tiles[getIndex(x, y)].reset();
+  if (auto slot = tileSlot(x, y))
+    slot->reset();
 }
 
 void Layer::clearTiles() {
   std::fill(tiles.begin(), tiles.end(), std::shared_ptr<Platform>());
+  for (auto &chunk : chunks) {
+    std::fill(chunk.second.begin(), chunk.second.end(),
+              std::shared_ptr<Platform>());
+  }
 }
 
 bool Layer::inBounds(int x, int y) const {
+  if (chunked) {
+    return hasChunk(floorDiv(x, chunkWidth), floorDiv(y, chunkHeight));
+  }
   return x >= 0 && x < width && y >= 0 && y < height;
 }
 
@@ -45,10 +55,13 @@ Layer::getTilesInRect(const SDL_FRect &rect) const {
   worldToTile(static_cast<int>(std::floor(rect.x + rect.w)),
               static_cast<int>(std::floor(rect.y + rect.h)), x1, y1);
 
-  x0 = std::max(0, x0);
-  y0 = std::max(0, y0);
-  x1 = std::min(width - 1, x1);
-  y1 = std::min(height - 1, y1);
+  // Chunked layers have no fixed extent; missing chunks just yield nothing
+  if (!chunked) {
+    x0 = std::max(0, x0);
+    y0 = std::max(0, y0);
+    x1 = std::min(width - 1, x1);
+    y1 = std::min(height - 1, y1);
+  }
 
   std::vector<std::shared_ptr<Platform>> result;
   for (int y = y0; y <= y1; ++y) {
@@ -62,58 +75,84 @@ Layer::getTilesInRect(const SDL_FRect &rect) const {
 }
 
 std::vector<std::shared_ptr<Platform>> Layer::getAllTiles() const {
+  auto notEmpty = [](const std::shared_ptr<Platform> &p) {
+    return static_cast<bool>(p);
+  };
+
   std::vector<std::shared_ptr<Platform>> result;
-  result.reserve(std::count_if(
-      tiles.begin(), tiles.end(),
-      [](const std::shared_ptr<Platform> &p) { return static_cast<bool>(p); }));
+  size_t count = std::count_if(tiles.begin(), tiles.end(), notEmpty);
+  for (const auto &chunk : chunks) {
+    count += std::count_if(chunk.second.begin(), chunk.second.end(), notEmpty);
+  }
+  result.reserve(count);
+
   for (auto &tile : tiles) {
     if (tile)
       result.push_back(tile);
   }
+  for (const auto &chunk : chunks) {
+    for (auto &tile : chunk.second) {
+      if (tile)
+        result.push_back(tile);
+    }
+  }
   return result;
 }
 
-void Layer::render(SDL_Renderer *renderer) const {
-  if (!renderer || !visible)
+void Layer::render(RenderSnapshot &snapshot,
+                   const TileAnimator *animator) const {
+  if (!visible)
     return;
 
   // Set layer opacity if supported (SDL2 doesn't have direct layer opacity,
   // but we can apply it to individual sprites)
+  if (chunked) {
+    for (const auto &chunk : chunks) {
+      for (const auto &tile : chunk.second) {
+        if (tile)
+          renderTile(snapshot, tile, animator);
+      }
+    }
+    return;
+  }
+
   for (int y = 0; y < height; ++y) {
     for (int x = 0; x < width; ++x) {
-      auto tile = getTile(x, y);
-      if (!tile)
-        continue;
+      const auto &tile = tiles[getIndex(x, y)];
+      if (tile)
+        renderTile(snapshot, tile, animator);
+    }
+  }
+}
 
-      auto sprite = tile->getSprite();
-      if (!sprite)
-        continue;
+void Layer::renderTile(RenderSnapshot &snapshot,
+                       const std::shared_ptr<Platform> &tile,
+                       const TileAnimator *animator) const {
+  auto sprite = tile->getSprite();
+  if (!sprite)
+    return;
 
-      // Apply opacity to the sprite's texture
-      if (opacity < 1.0f) {
-        SDL_SetTextureAlphaMod(sprite->getTexture()->get(),
-                               static_cast<Uint8>(ALPHA_OPAQUE * opacity));
-      }
+  if (tile->getPlatformType() == PlatformType::TRAP) {
+    sprite->setDestRect(
+        std::static_pointer_cast<TrapPlatform>(tile)->getOriginalBounds());
+  } else
+    sprite->setDestRect(tile->getCollisionBounds());
 
-      if (tile->getPlatformType() == PlatformType::TRAP) {
-        sprite->setDestRect(
-            std::static_pointer_cast<TrapPlatform>(tile)->getOriginalBounds());
-      } else
-        sprite->setDestRect(tile->getCollisionBounds());
-      sprite->render(renderer);
+  // Animated tiles share their type's frame, resolved once per update
+  if (animator && tile->getAnimationSlot() >= 0)
+    sprite->setSrcRect(animator->frame(tile->getAnimationSlot()));
 
-      // Reset alpha mod if we changed it
-      if (opacity < 1.0f) {
-        SDL_SetTextureAlphaMod(sprite->getTexture()->get(), ALPHA_OPAQUE);
-      }
-    }
-  }
+  // Layer opacity travels with the draw; it is applied when the snapshot is
+  // drawn
+  sprite->render(snapshot, SDL_FLIP_NONE,
+                 static_cast<Uint8>(ALPHA_OPAQUE * opacity));
 }
 
 void Layer::loadFromTMXLayer(
     const TMXParser::Layer &tmxLayer,
     const std::vector<TMXParser::TilesetInfo> &tilesets,
-    const std::vector<std::shared_ptr<Texture>> &tilesetTextures) {
+    const std::vector<std::shared_ptr<Texture>> &tilesetTextures,
+    const TileAnimator *animator) {
   name = tmxLayer.name;
   visible = tmxLayer.visible;
   opacity = tmxLayer.opacity;
@@ -122,29 +161,6 @@ void Layer::loadFromTMXLayer(
   clearTiles();
 
   for (size_t i = 0; i < tmxLayer.data.size(); ++i) {
-    int gid = tmxLayer.data[i];
-    if (gid == 0)
-      continue; // Skip empty tiles
-
-    // Find which tileset this GID belongs to
-    int tilesetIndex = -1;
-    int localGid = gid;
-    for (size_t j = 0; j < tilesets.size(); ++j) {
-      if (gid >= tilesets[j].firstGid) {
-        if (j == tilesets.size() - 1 || gid < tilesets[j + 1].firstGid) {
-          tilesetIndex = static_cast<int>(j);
-          localGid = gid - tilesets[j].firstGid;
-          break;
-        }
-      }
-    }
-
-    if (tilesetIndex == -1 ||
-        tilesetIndex >= static_cast<int>(tilesetTextures.size()) ||
-        !tilesetTextures[tilesetIndex]) {
-      continue; // Skip if tileset not found or texture failed to load
-    }
-
     int tx = static_cast<int>(i % static_cast<size_t>(width));
     int ty = static_cast<int>(i / static_cast<size_t>(width));
 
@@ -152,38 +168,123 @@ void Layer::loadFromTMXLayer(
     if (!inBounds(tx, ty))
       continue;
 
-    float x_ = static_cast<float>(tx * tileSizeW);
-    float y_ = static_cast<float>(ty * tileSizeH);
-    float w_ = static_cast<float>(tileSizeW);
-    float h_ = static_cast<float>(tileSizeH);
-    SDL_FRect destRect = {x_, y_, w_, h_};
-
-    const auto &currentTileset = tilesets[tilesetIndex];
-    auto tile =
-        std::make_shared<Platform>(destRect, tilesetTextures[tilesetIndex]);
-
-    // Calculate source rectangle in the tileset
-    const int cols = currentTileset.columns;
-    const int srcTilesWidth = currentTileset.tilesWidth;
-    const int srcTilesHeight = currentTileset.tilesHeight;
-    int _x = (localGid % cols) * srcTilesWidth;
-    int _y = (localGid / cols) * srcTilesHeight;
-    int _w = srcTilesWidth;
-    int _h = srcTilesHeight;
-    SDL_Rect srcRect = {_x, _y, _w, _h};
-
-    tile->getSprite()->setSrcRect(srcRect);
-    tile->getSprite()->setDestRect(destRect);
-    setTile(tx, ty, tile);
+    auto tile = createTile(tmxLayer.data[i], tx, ty, tileSizeW, tileSizeH,
+                           tilesets, tilesetTextures, animator);
+    if (tile)
+      setTile(tx, ty, tile);
   }
 }
 
+std::shared_ptr<Platform> Layer::createTile(
+    int gid, int tx, int ty, int tileSizeW, int tileSizeH,
+    const std::vector<TMXParser::TilesetInfo> &tilesets,
+    const std::vector<std::shared_ptr<Texture>> &tilesetTextures,
+    const TileAnimator *animator) {
+  if (gid == 0)
+    return nullptr; // Skip empty tiles
+
+  // Find which tileset this GID belongs to
+  int tilesetIndex = -1;
+  int localGid = gid;
+  for (size_t j = 0; j < tilesets.size(); ++j) {
+    if (gid >= tilesets[j].firstGid) {
+      if (j == tilesets.size() - 1 || gid < tilesets[j + 1].firstGid) {
+        tilesetIndex = static_cast<int>(j);
+        localGid = gid - tilesets[j].firstGid;
+        break;
+      }
+    }
+  }
+
+  if (tilesetIndex == -1 ||
+      tilesetIndex >= static_cast<int>(tilesetTextures.size()) ||
+      !tilesetTextures[tilesetIndex]) {
+    return nullptr; // Skip if tileset not found or texture failed to load
+  }
+
+  float x_ = static_cast<float>(tx * tileSizeW);
+  float y_ = static_cast<float>(ty * tileSizeH);
+  float w_ = static_cast<float>(tileSizeW);
+  float h_ = static_cast<float>(tileSizeH);
+  SDL_FRect destRect = {x_, y_, w_, h_};
+
+  const auto &currentTileset = tilesets[tilesetIndex];
+  auto tile =
+      std::make_shared<Platform>(destRect, tilesetTextures[tilesetIndex]);
+
+  tile->getSprite()->setSrcRect(tileSrcRect(currentTileset, localGid));
+  tile->getSprite()->setDestRect(destRect);
+  if (animator)
+    tile->setAnimationSlot(animator->slotOf(gid));
+  return tile;
+}
+
+SDL_Rect Layer::tileSrcRect(const TMXParser::TilesetInfo &tileset,
+                            int localId) {
+  // Calculate source rectangle in the tileset
+  const int cols = tileset.columns;
+  const int srcTilesWidth = tileset.tilesWidth;
+  const int srcTilesHeight = tileset.tilesHeight;
+  int _x = (localId % cols) * srcTilesWidth;
+  int _y = (localId / cols) * srcTilesHeight;
+  return SDL_Rect{_x, _y, srcTilesWidth, srcTilesHeight};
+}
+
+void Layer::enableChunks(int chunkWidth, int chunkHeight) {
+  chunked = true;
+  this->chunkWidth = std::max(1, chunkWidth);
+  this->chunkHeight = std::max(1, chunkHeight);
+
+  // Dense storage is unused in chunked mode
+  tiles.clear();
+  tiles.shrink_to_fit();
+}
+
+void Layer::setChunk(int cx, int cy,
+                     std::vector<std::shared_ptr<Platform>> chunkTiles) {
+  if (!chunked)
+    return;
+  chunkTiles.resize(static_cast<size_t>(chunkWidth) *
+                    static_cast<size_t>(chunkHeight));
+  chunks[chunkKey(cx, cy)] = std::move(chunkTiles);
+}
+
+void Layer::removeChunk(int cx, int cy) { chunks.erase(chunkKey(cx, cy)); }
+
+bool Layer::hasChunk(int cx, int cy) const {
+  return chunks.find(chunkKey(cx, cy)) != chunks.end();
+}
+
 size_t Layer::getIndex(int x, int y) const {
   return static_cast<size_t>(y) * static_cast<size_t>(width) +
          static_cast<size_t>(x);
 }
 
 void Layer::worldToTile(int wx, int wy, int &tx, int &ty) const {
-  tx = wx / tileSizeW;
-  ty = wy / tileSizeH;
+  tx = floorDiv(wx, tileSizeW);
+  ty = floorDiv(wy, tileSizeH);
+}
+
+std::shared_ptr<Platform> *Layer::tileSlot(int x, int y) {
+  return const_cast<std::shared_ptr<Platform> *>(
+      static_cast<const Layer *>(this)->tileSlot(x, y));
+}
+
+const std::shared_ptr<Platform> *Layer::tileSlot(int x, int y) const {
+  if (!chunked) {
+    if (!inBounds(x, y))
+      return nullptr;
+    return &tiles[getIndex(x, y)];
+  }
+
+  int cx = floorDiv(x, chunkWidth);
+  int cy = floorDiv(y, chunkHeight);
+  auto it = chunks.find(chunkKey(cx, cy));
+  if (it == chunks.end())
+    return nullptr;
+
+  size_t local = static_cast<size_t>(y - cy * chunkHeight) *
+                     static_cast<size_t>(chunkWidth) +
+                 static_cast<size_t>(x - cx * chunkWidth);
+  return &it->second[local];
 }
@@ -1,14 +1,84 @@
 #include "../include/config.h"
+#include "../include/frame_limiter.h"
 #include "../include/game.h"
 #include "../include/tmx_parser.h"
+#include "../include/vfs.h"
+#include <cstring>
 #include <iostream>
+#include <string>
+
+namespace {
+
+// Value of "--name=value" if arg is that option
+const char *optionValue(const char *arg, const char *name) {
+  const size_t length = std::strlen(name);
+  if (std::strncmp(arg, name, length) == 0 && arg[length] == '=')
+    return arg + length + 1;
+  return nullptr;
+}
+
+} // namespace
+
+int main(int argc, char *argv[]) {
+  // Frame pacing: --pacing=vsync (default), --pacing=uncapped or
+  // --pacing=<fps> for a fixed cap. F3 cycles the modes while playing.
+  // Replays: --record=<file> saves the session, --replay=<file> plays one
+  // back; add --headless to run it without a window or audio, as fast as
+  // possible (a reproducible benchmark).
+  PacingMode pacing = PacingMode::VSYNC;
+  int targetFps = FRAME_CAP_DEFAULT_FPS;
+  std::string recordPath, replayPath;
+  bool headless = false;
+  for (int i = 1; i < argc; ++i) {
+    if (const char *value = optionValue(argv[i], "--pacing")) {
+      if (!FrameLimiter::parseMode(value, pacing, targetFps)) {
+        std::cerr << "Unknown pacing " << value
+                  << " (expected vsync, uncapped or a frame rate)"
+                  << std::endl;
+      }
+    } else if (const char *value = optionValue(argv[i], "--record")) {
+      recordPath = value;
+    } else if (const char *value = optionValue(argv[i], "--replay")) {
+      replayPath = value;
+    } else if (std::strcmp(argv[i], "--headless") == 0) {
+      headless = true;
+    } else {
+      std::cerr << "Unknown option " << argv[i] << std::endl;
+    }
+  }
+  if (headless && replayPath.empty()) {
+    std::cerr << "--headless needs --replay=<file>" << std::endl;
+    return 1;
+  }
+
+  // Assets come from the pack next to the executable, wherever it runs from
+  Vfs::resources().mountDefault();
+
+  Uint32 windowFlags = SDL_WINDOW_SHOWN;
+  Uint32 rendererFlags = SDL_RENDERER_ACCELERATED;
+  if (headless) {
+    // No display needed: SDL's dummy video driver and a software renderer
+    SDL_setenv("SDL_VIDEODRIVER", "dummy", 1);
+    windowFlags = SDL_WINDOW_HIDDEN;
+    rendererFlags = SDL_RENDERER_SOFTWARE;
+    pacing = PacingMode::UNCAPPED;
+  } else if (pacing == PacingMode::VSYNC) {
+    rendererFlags |= SDL_RENDERER_PRESENTVSYNC;
+  }
 
-int main() {
-  SDL_Surface *loadedSurface = IMG_Load(PLAYER_TEXTURE_PATH);
   Game game(WINDOW_TITLE, PLAYER_TEXTURE_PATH, WINDOW_WIDTH, WINDOW_HEIGHT,
-            SDL_WINDOW_SHOWN,
-            SDL_RENDERER_ACCELERATED | SDL_RENDERER_PRESENTVSYNC);
+            windowFlags, rendererFlags);
+  game.setPacing(pacing, targetFps);
+  if (headless) {
+    game.setAudioBackend(std::make_unique<NullAudioBackend>());
+  }
+  if (!recordPath.empty()) {
+    game.recordReplay(recordPath);
+  }
+  if (!replayPath.empty() && !game.playReplay(replayPath, headless)) {
+    return 1;
+  }
   game.run();
 
   return 0;
-}
\ No newline at end of file
+}
@@ -1,5 +1,7 @@
 #include "../include/map.h"
+#include "../include/asset_loader.h"
 #include "../include/config.h"
+#include "../include/entity_systems.h"
 #include "collision_system.h"
 #include <algorithm>
 #include <cmath>
@@ -8,11 +10,14 @@
 Map::Map(int width, int height, int tileSizeW, int tileSizeH,
          const std::string &tmxFilePath)
     : width(width), height(height), tileSizeW(tileSizeW), tileSizeH(tileSizeH),
-      tmxParser(tmxFilePath), audioManager(nullptr) {
+      tmxParser(tmxFilePath) {
   tiles.resize(static_cast<size_t>(width) * static_cast<size_t>(height));
 }
 
-Map::~Map() = default;
+Map::~Map() {
+  // The streaming thread builds chunks from map state; stop it first
+  chunkStreamer.reset();
+}
 
 void Map::init(SDL_Renderer *renderer) {
   try {
@@ -22,9 +27,26 @@ void Map::init(SDL_Renderer *renderer) {
     return;
   }
 
+  // Use the shared scheduler if we have one, otherwise spin one up for this
+  // load
+  std::shared_ptr<JobSystem> jobs = jobSystem;
+  if (!jobs) {
+    jobs = std::make_shared<JobSystem>();
+  }
+
+  // Stop streaming the previous map before its state is replaced
+  chunkStreamer.reset();
+  chunkEntities.clear();
+  coinTiles.clear();
+  collectedCoinTiles.clear();
+  infinite = false;
+  originTileX = 0;
+  originTileY = 0;
+  coinLayerIndex = -1;
+
   TMXParser::MapInfo mapInfo = tmxParser.getMapInfo();
   auto tilesetInfo = tmxParser.getTilesetInfo();
-  auto layersInfo = tmxParser.getLayersInfo();
+  const auto &layersInfo = tmxParser.getLayersInfo();
 
   width = mapInfo.mapWidth;
   height = mapInfo.mapHeight;
@@ -34,13 +56,34 @@ void Map::init(SDL_Renderer *renderer) {
   // Clear existing layers
   layers.clear();
   tilesetTextures.clear();
+  registry.clear();
+  disappearingPlatforms.clear();
+  disappearingTiles.clear();
+  tileAnimator.build(tilesetInfo);
+
+  // Load textures for all tilesets. Texture creation talks to the renderer,
+  // so it stays on this thread. Tilesets sharing an image share a texture.
+  std::shared_ptr<TextureCache> cache = textureCache;
+  if (!cache) {
+    cache = std::make_shared<TextureCache>(renderer);
+  }
+
+  // Decode the tileset images in parallel; only the uploads happen here
+  AssetLoader images(jobs);
+  for (const auto &tileset : tilesetInfo) {
+    if (!tileset.imagePath.empty() && !cache->contains(tileset.imagePath)) {
+      images.loadImage(tileset.imagePath);
+    }
+  }
 
-  // Load textures for all tilesets
   for (const auto &tileset : tilesetInfo) {
     if (!tileset.imagePath.empty()) {
       try {
         auto texture =
-            std::make_shared<Texture>(renderer, tileset.imagePath.c_str());
+            cache->contains(tileset.imagePath)
+                ? cache->load(tileset.imagePath)
+                : cache->load(tileset.imagePath,
+                              images.takeImage(tileset.imagePath).get());
         tilesetTextures.push_back(texture);
         std::cout << "Loaded tileset texture: " << tileset.imagePath
                   << std::endl;
@@ -59,219 +102,467 @@ void Map::init(SDL_Renderer *renderer) {
     assets = tilesetTextures[0];
   }
 
-  // Create layers from TMX data
+  totalCoins = 0;
+  collectedCoins = 0;
+
+  // Infinite maps are streamed in chunk by chunk as the player moves
+  if (mapInfo.infinite) {
+    initStreaming(tilesetInfo, layersInfo);
+    return;
+  }
+
+  // Build every layer on the job system
+  std::vector<std::future<LayerBuild>> pending;
+  pending.reserve(layersInfo.size());
   for (const auto &layerInfo : layersInfo) {
-    auto layer = std::make_unique<Layer>(layerInfo.name, width, height,
-                                         tileSizeW, tileSizeH);
-    layer->loadFromTMXLayer(layerInfo, tilesetInfo, tilesetTextures);
-    // Make background layer non-collidable
-    // Set background name from the config file
+    pending.push_back(jobs->submit([this, &layerInfo, &tilesetInfo]() {
+      return buildLayer(layerInfo, tilesetInfo);
+    }));
+  }
 
-    if (layer->getName() == BACK_GROUND) {
-      layer->setCollidable(false);
+  // Merge results in layer order so the outcome never depends on scheduling
+  for (size_t i = 0; i < pending.size(); ++i) {
+    LayerBuild build = pending[i].get();
+    const auto &layerInfo = layersInfo[i];
+
+    if (build.isCoinLayer) {
+      totalCoins += build.coinCount;
     }
 
-    // handle trophies layer
-    if (layer->getName() == COINS_LAYER_NAME) {
-      auto preCoins = layer->getAllTiles();
-      totalCoins = preCoins.size(); // Track total number of coins
-      collectedCoins = 0;           // Reset collected count
-      originalCoinBounds.clear();   // Clear previous bounds
-
-      // Store template data from first coin for respawning
-      if (!preCoins.empty()) {
-        auto firstCoin = preCoins[0];
-        coinTexture = firstCoin->getTexture();
-        if (firstCoin->getSprite()) {
-          coinSrcRect = firstCoin->getSprite()->getSrcRect();
-        } else {
-          coinSrcRect = {0, 0, DEFAULT_TILE_WIDTH, DEFAULT_TILE_HEIGHT};
-        }
-      }
+    for (const EntitySpawn &description : build.spawns) {
+      spawn(description);
+    }
+    for (const auto &platform : build.disappearingPlatforms) {
+      disappearingPlatforms.push_back(platform);
+      disappearingTiles[tileKeyOf(*platform)] = platform.get();
+    }
 
-      for (auto pc : preCoins) {
-        // Handle each coin tile
-        SDL_FRect bounds = pc->getCollisionBounds();
-
-        // Store original bounds for respawning (position AND size)
-        originalCoinBounds.push_back(bounds);
-
-        auto coin = std::make_shared<Projectile>(
-            bounds, Projectile::ProjectileType::COIN, pc->getTexture());
-        // Don't take ownership of the platform's sprite (it is owned by the
-        // platform via a unique_ptr). Instead create a new Sprite that uses
-        // the same Texture and copy the source rect. This avoids double-free
-        // and keeps platform rendering intact.
-        if (pc->getTexture()) {
-          auto spriteShared = std::make_shared<Sprite>(pc->getTexture().get());
-          if (pc->getSprite()) {
-            spriteShared->setSrcRect(pc->getSprite()->getSrcRect());
-          }
-          spriteShared->setDestRect(bounds);
-          coin->setSprite(spriteShared);
-        }
-        // Set audio manager for coin sound
-        coin->setAudioManager(audioManager);
+    if (layerInfo.name == DISAPPEAR_LAYER_NAME) {
+      std::cout << "Created disappearing layer: " << layerInfo.name << " ("
+                << build.disappearingPlatforms.size() << " platforms)"
+                << std::endl;
+    } else if (layerInfo.name == TRAPS_LAYER_NAME) {
+      std::cout << "Created trap layer: " << layerInfo.name << " ("
+                << build.layer->getAllTiles().size() << " traps)"
+                << std::endl;
+    } else if (layerInfo.name == ARROW_LAYER_NAME) {
+      std::cout << "Created arrow layer: " << layerInfo.name << " ("
+                << build.spawns.size() << " arrows)" << std::endl;
+    }
 
-        // Add coin to map's projectile list so it will be updated and rendered
-        // with the rest of projectiles.
-        projectiles.push_back(coin);
-      }
+    std::cout << "Created layer: " << layerInfo.name
+              << " (visible: " << layerInfo.visible << ")" << std::endl;
 
-      std::cout << "Created layer: " << layerInfo.name
-                << " (visible: " << layerInfo.visible << ")" << std::endl;
-      continue;
+    if (build.keepLayer) {
+      layers.push_back(std::move(build.layer));
     }
+  }
 
-    // handle disappearing platforms layer
-    if (layer->getName() == DISAPPEAR_LAYER_NAME) {
-      auto disappearTiles = layer->getAllTiles();
-      for (auto tile : disappearTiles) {
-        SDL_FRect bounds = tile->getCollisionBounds();
-        auto disappearPlatform =
-            std::make_shared<DisappearingPlatform>(bounds, tile->getTexture());
-
-        // Copy sprite properties
-        if (tile->getSprite()) {
-          disappearPlatform->getSprite()->setSrcRect(
-              tile->getSprite()->getSrcRect());
-          disappearPlatform->getSprite()->setDestRect(bounds);
+  // Tiles are built; the raw GIDs are no longer needed
+  tmxParser.releaseLayerData();
+
+  // Legacy support: copy first layer's tiles to the legacy tiles vector
+  tiles.assign(static_cast<size_t>(width) * static_cast<size_t>(height),
+               nullptr);
+  if (!layers.empty()) {
+    for (int y = 0; y < height; ++y) {
+      for (int x = 0; x < width; ++x) {
+        auto tile = layers[0]->getTile(x, y);
+        if (tile) {
+          size_t index = static_cast<size_t>(y) * static_cast<size_t>(width) +
+                         static_cast<size_t>(x);
+          tiles[index] = tile;
         }
+      }
+    }
+  }
+}
 
-        disappearingPlatforms.push_back(disappearPlatform);
+Map::LayerBuild
+Map::buildLayer(const TMXParser::Layer &layerInfo,
+                const std::vector<TMXParser::TilesetInfo> &tilesetInfo) const {
+  LayerBuild build;
+  build.layer = std::make_unique<Layer>(layerInfo.name, width, height,
+                                        tileSizeW, tileSizeH);
+  Layer *layer = build.layer.get();
+  layer->loadFromTMXLayer(layerInfo, tilesetInfo, tilesetTextures,
+                          &tileAnimator);
+
+  // Make background layer non-collidable
+  // Set background name from the config file
+  if (layer->getName() == BACK_GROUND) {
+    layer->setCollidable(false);
+  }
 
-        // Replace the regular platform with the disappearing one in the layer
-        layer->clearTiles();
-        // Note: We'll manage disappearing platforms separately
-      }
+  // handle trophies layer
+  if (layer->getName() == COINS_LAYER_NAME) {
+    auto preCoins = layer->getAllTiles();
+    build.isCoinLayer = true;
+    build.keepLayer = false; // Coins live on as entities only
+    build.coinCount = static_cast<int>(preCoins.size());
 
-      std::cout << "Created disappearing layer: " << layerInfo.name << " ("
-                << disappearTiles.size() << " platforms)" << std::endl;
+    for (auto pc : preCoins) {
+      build.spawns.push_back(makeCoin(pc));
     }
+    return build;
+  }
 
-    // handle trap platforms layer
-    if (layer->getName() == TRAPS_LAYER_NAME) {
-      auto trapTiles = layer->getAllTiles();
-      for (auto tile : trapTiles) {
-        SDL_FRect bounds = tile->getCollisionBounds();
-        auto trapPlatform =
-            std::make_shared<TrapPlatform>(bounds, tile->getTexture());
-
-        // Copy sprite properties
-        if (tile->getSprite()) {
-          trapPlatform->getSprite()->setSrcRect(
-              tile->getSprite()->getSrcRect());
-          trapPlatform->getSprite()->setDestRect(bounds);
-        }
+  // handle disappearing platforms layer
+  if (layer->getName() == DISAPPEAR_LAYER_NAME) {
+    auto disappearTiles = layer->getAllTiles();
+    for (auto tile : disappearTiles) {
+      build.disappearingPlatforms.push_back(makeDisappearing(tile));
+    }
 
-        // Replace the regular platform with the trap platform in the layer
-        // We need to find the tile position and replace it
-        for (int y = 0; y < height; ++y) {
-          for (int x = 0; x < width; ++x) {
-            auto layerTile = layer->getTile(x, y);
-            if (layerTile == tile) {
-              layer->setTile(x, y,
-                             std::static_pointer_cast<Platform>(trapPlatform));
-              break;
-            }
-          }
-        }
+    // Disappearing platforms are managed separately, not as layer tiles
+    layer->clearTiles();
+  }
+
+  // handle trap platforms layer
+  if (layer->getName() == TRAPS_LAYER_NAME) {
+    for (int y = 0; y < height; ++y) {
+      for (int x = 0; x < width; ++x) {
+        auto tile = layer->getTile(x, y);
+        if (!tile)
+          continue;
+
+        // Replace the regular platform with the trap platform in place
+        layer->setTile(x, y, makeTrap(tile));
       }
+    }
+  }
 
-      std::cout << "Created trap layer: " << layerInfo.name << " ("
-                << trapTiles.size() << " traps)" << std::endl;
+  // handle arrow layer
+  if (layer->getName() == ARROW_LAYER_NAME) {
+    auto arrowTiles = layer->getAllTiles();
+    for (auto tile : arrowTiles) {
+      build.spawns.push_back(makeArrow(tile));
     }
 
-    // handle arrow projectiles layer
-    if (layer->getName() == ARROW_LAYER_NAME) {
-      auto arrowTiles = layer->getAllTiles();
-      for (auto tile : arrowTiles) {
-        SDL_FRect bounds = tile->getCollisionBounds();
-
-        // Create smaller arrow bounds
-        SDL_FRect arrowBounds = {bounds.x + (bounds.w - ARROW_WIDTH) / 2,
-                                 bounds.y + (bounds.h - ARROW_HEIGHT) / 2,
-                                 ARROW_WIDTH, ARROW_HEIGHT};
-
-        auto arrow = std::make_shared<Projectile>(
-            arrowBounds, Projectile::ProjectileType::ARROW, tile->getTexture());
-
-        // Store original position for respawning
-        arrow->setOriginalPosition(arrowBounds.x, arrowBounds.y);
-
-        // Copy sprite properties
-        if (tile->getTexture()) {
-          auto spriteShared =
-              std::make_shared<Sprite>(tile->getTexture().get());
-          if (tile->getSprite()) {
-            spriteShared->setSrcRect(tile->getSprite()->getSrcRect());
-          }
-          spriteShared->setDestRect(arrowBounds);
-          arrow->setSprite(spriteShared);
-        }
+    // Make layer non-collidable since arrows are handled as entities
+    layer->setCollidable(false);
+  }
 
-        // Determine arrow direction based on tile position
-        // Arrows on the left side of map move right, right side move left
-        // Arrows on top move down, bottom move up
-        float velocityX = 0.0f;
-        float velocityY = 0.0f;
-
-        // Get tile position in grid
-        int tileX = static_cast<int>(bounds.x / DEFAULT_TILE_WIDTH);
-        int tileY = static_cast<int>(bounds.y / DEFAULT_TILE_HEIGHT);
-
-        // Determine direction based on position
-        if (tileX < width / 2) {
-          // Left side of map - arrow moves right
-          velocityX = ARROW_SPEED;
-        } else {
-          // Right side of map - arrow moves left
-          velocityX = -ARROW_SPEED;
-        }
+  return build;
+}
 
-        // Optional: Add vertical movement for top/bottom tiles
-        if (tileY < height / 4) {
-          // Top area - also move down
-          velocityY = ARROW_SPEED * 0.5f;
-        } else if (tileY > height * 3 / 4) {
-          // Bottom area - also move up
-          velocityY = -ARROW_SPEED * 0.5f;
-        }
+EntitySpawn Map::makeCoin(const std::shared_ptr<Platform> &tile) const {
+  EntitySpawn coin;
+  coin.kind = EntitySpawn::Kind::COIN;
+  coin.bounds = tile->getCollisionBounds();
+  coin.texture = tile->getTexture().get();
+  coin.src = tile->getSprite() ? tile->getSprite()->getSrcRect()
+                               : SDL_Rect{0, 0, tileSizeW, tileSizeH};
+  coin.velocityX = 0.0f;
+  coin.velocityY = 0.0f;
+  return coin;
+}
 
-        arrow->setVelocity(velocityX, velocityY);
-        // Add the sound effect
-        if (audioManager) {
-          arrow->setAudioManager(audioManager);
-        }
-        projectiles.push_back(arrow);
+EntitySpawn Map::makeArrow(const std::shared_ptr<Platform> &tile) const {
+  SDL_FRect bounds = tile->getCollisionBounds();
+
+  // Create smaller arrow bounds
+  EntitySpawn arrow;
+  arrow.kind = EntitySpawn::Kind::ARROW;
+  arrow.bounds = {bounds.x + (bounds.w - ARROW_WIDTH) / 2,
+                  bounds.y + (bounds.h - ARROW_HEIGHT) / 2, ARROW_WIDTH,
+                  ARROW_HEIGHT};
+  arrow.texture = tile->getTexture().get();
+  arrow.src = tile->getSprite() ? tile->getSprite()->getSrcRect()
+                                : SDL_Rect{0, 0, tileSizeW, tileSizeH};
+
+  // Determine arrow direction based on tile position
+  // Arrows on the left side of map move right, right side move left
+  // Arrows on top move down, bottom move up
+  float velocityX = 0.0f;
+  float velocityY = 0.0f;
+
+  // Get tile position in grid, relative to the map's top-left corner
+  int tileX =
+      static_cast<int>(std::floor(bounds.x / DEFAULT_TILE_WIDTH)) - originTileX;
+  int tileY = static_cast<int>(std::floor(bounds.y / DEFAULT_TILE_HEIGHT)) -
+              originTileY;
+
+  // Determine direction based on position
+  if (tileX < width / 2) {
+    // Left side of map - arrow moves right
+    velocityX = ARROW_SPEED;
+  } else {
+    // Right side of map - arrow moves left
+    velocityX = -ARROW_SPEED;
+  }
+
+  // Optional: Add vertical movement for top/bottom tiles
+  if (tileY < height / 4) {
+    // Top area - also move down
+    velocityY = ARROW_SPEED * 0.5f;
+  } else if (tileY > height * 3 / 4) {
+    // Bottom area - also move up
+    velocityY = -ARROW_SPEED * 0.5f;
+  }
+
+  arrow.velocityX = velocityX;
+  arrow.velocityY = velocityY;
+  return arrow;
+}
+
+std::shared_ptr<TrapPlatform>
+Map::makeTrap(const std::shared_ptr<Platform> &tile) const {
+  SDL_FRect bounds = tile->getCollisionBounds();
+  auto trapPlatform =
+      std::make_shared<TrapPlatform>(bounds, tile->getTexture());
+
+  // Copy sprite properties
+  if (tile->getSprite()) {
+    trapPlatform->getSprite()->setSrcRect(tile->getSprite()->getSrcRect());
+    trapPlatform->getSprite()->setDestRect(bounds);
+  }
+  trapPlatform->setAnimationSlot(tile->getAnimationSlot());
+  return trapPlatform;
+}
+
+std::shared_ptr<DisappearingPlatform>
+Map::makeDisappearing(const std::shared_ptr<Platform> &tile) const {
+  SDL_FRect bounds = tile->getCollisionBounds();
+  auto disappearPlatform =
+      std::make_shared<DisappearingPlatform>(bounds, tile->getTexture());
+
+  // Copy sprite properties
+  if (tile->getSprite()) {
+    disappearPlatform->getSprite()->setSrcRect(tile->getSprite()->getSrcRect());
+    disappearPlatform->getSprite()->setDestRect(bounds);
+  }
+  disappearPlatform->setAnimationSlot(tile->getAnimationSlot());
+  return disappearPlatform;
+}
+
+void Map::initStreaming(
+    const std::vector<TMXParser::TilesetInfo> &tilesetInfo,
+    const std::vector<TMXParser::Layer> &layersInfo) {
+  infinite = true;
+
+  // The map extent is the bounding box of every chunk; chunks may sit at
+  // negative tile coordinates
+  int minX = 0, minY = 0, maxX = 0, maxY = 0;
+  int chunkW = 0, chunkH = 0;
+  bool first = true;
+  for (const auto &layerInfo : layersInfo) {
+    for (const auto &chunk : layerInfo.chunks) {
+      if (first) {
+        minX = chunk.x;
+        minY = chunk.y;
+        maxX = chunk.x + chunk.width;
+        maxY = chunk.y + chunk.height;
+        chunkW = chunk.width;
+        chunkH = chunk.height;
+        first = false;
+        continue;
       }
+      minX = std::min(minX, chunk.x);
+      minY = std::min(minY, chunk.y);
+      maxX = std::max(maxX, chunk.x + chunk.width);
+      maxY = std::max(maxY, chunk.y + chunk.height);
+    }
+  }
+  originTileX = minX;
+  originTileY = minY;
+  width = maxX - minX;
+  height = maxY - minY;
 
-      std::cout << "Created arrow layer: " << layerInfo.name << " ("
-                << arrowTiles.size() << " arrows)" << std::endl;
+  streamTilesets = tilesetInfo;
+  streamLayerNames.clear();
+  for (const auto &layerInfo : layersInfo) {
+    streamLayerNames.push_back(layerInfo.name);
+  }
 
-      // Make layer non-collidable since arrows are handled as projectiles
+  chunkStreamer = std::make_unique<ChunkStreamer>(
+      tmxParser.getFilePath(), chunkW, chunkH,
+      [this](const ChunkRequest &request, const std::vector<int> &gids,
+             ChunkLoad &load) { buildChunk(request, gids, load); });
+
+  // Every layer stays, even ones whose tiles all become objects, so streamer
+  // layer indices match the layers vector
+  size_t chunkCount = 0;
+  for (size_t i = 0; i < layersInfo.size(); ++i) {
+    const auto &layerInfo = layersInfo[i];
+    // Chunked layers have no dense extent
+    auto layer = std::make_unique<Layer>(layerInfo.name, 0, 0, tileSizeW,
+                                         tileSizeH);
+    layer->enableChunks(chunkW, chunkH);
+    layer->setVisible(layerInfo.visible);
+    layer->setOpacity(layerInfo.opacity);
+
+    // Background, arrows and coins never collide as tiles
+    if (layerInfo.name == BACK_GROUND || layerInfo.name == ARROW_LAYER_NAME ||
+        layerInfo.name == COINS_LAYER_NAME) {
       layer->setCollidable(false);
     }
 
-    std::cout << "Created layer: " << layerInfo.name
-              << " (visible: " << layerInfo.visible << ")" << std::endl;
+    // Coins are counted up front from the chunk index, so the win condition
+    // doesn't depend on what has been streamed in
+    if (layerInfo.name == COINS_LAYER_NAME && coinLayerIndex < 0) {
+      coinLayerIndex = static_cast<int>(i);
+      for (const auto &chunk : layerInfo.chunks) {
+        totalCoins += chunk.tileCount;
+      }
+    }
+
+    for (const auto &chunk : layerInfo.chunks) {
+      ChunkRequest request;
+      request.id = {static_cast<int>(i), Layer::floorDiv(chunk.x, chunkW),
+                    Layer::floorDiv(chunk.y, chunkH)};
+      request.tileX = chunk.x;
+      request.tileY = chunk.y;
+      request.width = chunk.width;
+      request.height = chunk.height;
+      request.dataOffset = chunk.dataOffset;
+      chunkStreamer->addChunk(request);
+    }
+    chunkCount += layerInfo.chunks.size();
+
+    std::cout << "Created streamed layer: " << layerInfo.name << " ("
+              << layerInfo.chunks.size() << " chunks)" << std::endl;
     layers.push_back(std::move(layer));
   }
 
-  // Legacy support: copy first layer's tiles to the legacy tiles vector
-  tiles.assign(static_cast<size_t>(width) * static_cast<size_t>(height),
-               nullptr);
-  if (!layers.empty()) {
-    for (int y = 0; y < height; ++y) {
-      for (int x = 0; x < width; ++x) {
-        auto tile = layers[0]->getTile(x, y);
-        if (tile) {
-          size_t index = static_cast<size_t>(y) * static_cast<size_t>(width) +
-                         static_cast<size_t>(x);
-          tiles[index] = tile;
-        }
+  // No legacy dense copy for streamed maps
+  tiles.clear();
+
+  std::cout << "Streaming infinite map: " << width << "x" << height
+            << " tiles in " << chunkCount << " chunks of " << chunkW << "x"
+            << chunkH << std::endl;
+}
+
+void Map::buildChunk(const ChunkRequest &request, const std::vector<int> &gids,
+                     ChunkLoad &load) const {
+  const std::string &name = streamLayerNames[request.id.layer];
+  const size_t count = std::min(
+      gids.size(), static_cast<size_t>(request.width) *
+                       static_cast<size_t>(request.height));
+
+  load.tiles.resize(static_cast<size_t>(request.width) *
+                    static_cast<size_t>(request.height));
+  size_t tileCount = 0;
+  for (size_t i = 0; i < count; ++i) {
+    int tx = request.tileX + static_cast<int>(i % request.width);
+    int ty = request.tileY + static_cast<int>(i / request.width);
+    auto tile = Layer::createTile(gids[i], tx, ty, tileSizeW, tileSizeH,
+                                  streamTilesets, tilesetTextures,
+                                  &tileAnimator);
+    if (!tile)
+      continue;
+
+    // Same conversions as buildLayer, one tile at a time
+    if (name == COINS_LAYER_NAME) {
+      load.spawns.push_back(makeCoin(tile));
+    } else if (name == DISAPPEAR_LAYER_NAME) {
+      load.disappearingPlatforms.push_back(makeDisappearing(tile));
+    } else if (name == TRAPS_LAYER_NAME) {
+      load.tiles[i] = makeTrap(tile);
+      ++tileCount;
+    } else {
+      if (name == ARROW_LAYER_NAME) {
+        load.spawns.push_back(makeArrow(tile));
       }
+      load.tiles[i] = tile;
+      ++tileCount;
+    }
+  }
+
+  // Rough resident size, used only against the streaming memory budget
+  load.bytes = load.tiles.size() * sizeof(std::shared_ptr<Platform>) +
+               tileCount * (sizeof(TrapPlatform) + sizeof(Sprite)) +
+               load.spawns.size() * sizeof(EntitySpawn) +
+               load.disappearingPlatforms.size() *
+                   (sizeof(DisappearingPlatform) + sizeof(Sprite));
+}
+
+void Map::installChunk(ChunkLoad &load) {
+  const ChunkId id = load.id;
+  if (id.layer < 0 || id.layer >= static_cast<int>(layers.size()))
+    return;
+
+  layers[id.layer]->setChunk(id.x, id.y, std::move(load.tiles));
+
+  ChunkEntities &entities = chunkEntities[id];
+  for (const EntitySpawn &description : load.spawns) {
+    const Entity entity = spawn(description);
+    entities.entities.push_back(entity);
+
+    // Coins collected before the chunk was evicted stay collected
+    if (description.kind == EntitySpawn::Kind::COIN) {
+      const SDL_FRect &bounds = description.bounds;
+      long long key = Layer::chunkKey(
+          Layer::floorDiv(static_cast<int>(bounds.x), tileSizeW),
+          Layer::floorDiv(static_cast<int>(bounds.y), tileSizeH));
+      coinTiles[entity] = key;
+      if (collectedCoinTiles.count(key))
+        registry.setActive(entity, false);
+    }
+  }
+
+  for (auto &platform : load.disappearingPlatforms) {
+    entities.disappearingPlatforms.push_back(platform);
+    disappearingPlatforms.push_back(platform);
+    disappearingTiles[tileKeyOf(*platform)] = platform.get();
+  }
+}
+
+void Map::uninstallChunk(const ChunkId &id) {
+  if (id.layer >= 0 && id.layer < static_cast<int>(layers.size())) {
+    layers[id.layer]->removeChunk(id.x, id.y);
+  }
+
+  auto it = chunkEntities.find(id);
+  if (it == chunkEntities.end())
+    return;
+
+  const ChunkEntities &entities = it->second;
+  for (Entity entity : entities.entities) {
+    // Remember which coins were collected so they stay gone when the chunk
+    // is streamed in again
+    auto coin = coinTiles.find(entity);
+    if (coin != coinTiles.end()) {
+      if (!registry.isActive(entity))
+        collectedCoinTiles.insert(coin->second);
+      coinTiles.erase(coin);
+    }
+    registry.destroy(entity);
+  }
+
+  if (!entities.disappearingPlatforms.empty()) {
+    std::unordered_set<const DisappearingPlatform *> owned;
+    for (const auto &platform : entities.disappearingPlatforms) {
+      owned.insert(platform.get());
+      disappearingTiles.erase(tileKeyOf(*platform));
     }
+    disappearingPlatforms.erase(
+        std::remove_if(
+            disappearingPlatforms.begin(), disappearingPlatforms.end(),
+            [&owned](const std::shared_ptr<DisappearingPlatform> &platform) {
+              return owned.count(platform.get()) > 0;
+            }),
+        disappearingPlatforms.end());
+  }
+
+  chunkEntities.erase(it);
+}
+
+void Map::updateStreaming(const SDL_FRect &focus) {
+  if (!chunkStreamer)
+    return;
+
+  int focusTileX = Layer::floorDiv(static_cast<int>(focus.x + focus.w / 2),
+                                   tileSizeW);
+  int focusTileY = Layer::floorDiv(static_cast<int>(focus.y + focus.h / 2),
+                                   tileSizeH);
+  auto update = chunkStreamer->update(focusTileX, focusTileY);
+
+  for (const auto &id : update.evicted) {
+    uninstallChunk(id);
+  }
+  for (auto &load : update.loaded) {
+    installChunk(load);
   }
 }
 
@@ -279,6 +570,13 @@ int Map::getWidth() const { return width; }
 int Map::getHeight() const { return height; }
 int Map::getTileSize() const { return tileSizeW; }
 
+SDL_FRect Map::getWorldBounds() const {
+  return {static_cast<float>(originTileX * tileSizeW),
+          static_cast<float>(originTileY * tileSizeH),
+          static_cast<float>(width * tileSizeW),
+          static_cast<float>(height * tileSizeH)};
+}
+
 // Layer management
 int Map::getLayerCount() const { return static_cast<int>(layers.size()); }
 
@@ -322,20 +620,20 @@ void Map::setLayerCollidable(int index, bool collidable) {
 }
 
 void Map::setTile(int x, int y, std::shared_ptr<Platform> tile) {
-  if (!inBounds(x, y))
+  if (!inBounds(x, y) || tiles.empty())
     return;
   tiles[static_cast<size_t>(y) * width + static_cast<size_t>(x)] =
       std::move(tile);
 }
 
 std::shared_ptr<Platform> Map::getTile(int x, int y) const {
-  if (!inBounds(x, y))
+  if (!inBounds(x, y) || tiles.empty())
     return nullptr;
   return tiles[static_cast<size_t>(y) * width + static_cast<size_t>(x)];
 }
 
 void Map::removeTile(int x, int y) {
-  if (!inBounds(x, y))
+  if (!inBounds(x, y) || tiles.empty())
     return;
   tiles[static_cast<size_t>(y) * width + static_cast<size_t>(x)].reset();
 }
@@ -390,6 +688,27 @@ Map::getTilesInRect(const SDL_FRect &rect) const {
   return result;
 }
 
+bool Map::isSolid(int tx, int ty) const {
+  for (const auto &layer : layers) {
+    if (!layer->isCollidable())
+      continue;
+
+    const Platform *tile = layer->tileAt(tx, ty);
+    if (tile && tile->getPlatformType() != PlatformType::TRAP)
+      return true;
+  }
+
+  auto it = disappearingTiles.find(Layer::chunkKey(tx, ty));
+  return it != disappearingTiles.end() && it->second->canCollide();
+}
+
+long long Map::tileKeyOf(const Platform &platform) const {
+  const auto pos = platform.getPos();
+  return Layer::chunkKey(
+      Layer::floorDiv(static_cast<int>(std::floor(pos.first)), tileSizeW),
+      Layer::floorDiv(static_cast<int>(std::floor(pos.second)), tileSizeH));
+}
+
 std::vector<std::shared_ptr<Platform>> Map::getAllTiles() const {
   std::vector<std::shared_ptr<Platform>> result;
 
@@ -402,53 +721,64 @@ std::vector<std::shared_ptr<Platform>> Map::getAllTiles() const {
   return result;
 }
 
-void Map::render(SDL_Renderer *renderer, float dt) const {
-  if (!renderer)
-    return;
-
+void Map::render(RenderSnapshot &snapshot) const {
   // Render all visible layers in order
   for (const auto &layer : layers) {
-    layer->render(renderer);
+    layer->render(snapshot, &tileAnimator);
   }
 
   // render disappearing platforms (only if visible)
   for (const auto &platform : disappearingPlatforms) {
     if (platform->isVisible() && platform->getSprite()) {
-      platform->getSprite()->render(renderer);
+      if (platform->getAnimationSlot() >= 0) {
+        platform->getSprite()->setSrcRect(
+            tileAnimator.frame(platform->getAnimationSlot()));
+      }
+      platform->getSprite()->render(snapshot);
     }
   }
 
-  // render projectiles
-  for (const auto &project : projectiles) {
-    project->render(renderer);
-  }
+  // render coins and arrows
+  EntitySystems::render(registry, snapshot);
 }
 
-void Map::updateProjectiles(float dt) {
-  SDL_Rect worldBounds = {0, 0, width * tileSizeW, height * tileSizeH};
-  for (auto &project : projectiles) {
-    project->update(dt, worldBounds);
-  }
+void Map::updateEntities(float dt) {
+  EntitySystems::move(registry, dt, getWorldBounds(), jobSystem.get());
+  EntitySystems::animate(registry, dt, jobSystem.get());
 }
 
-void Map::removeDeadProjectiles() {
-  auto it = std::remove_if(projectiles.begin(), projectiles.end(),
-                           [](const std::shared_ptr<Projectile> &proj) {
-                             return proj->shouldBeRemoved();
-                           });
-  projectiles.erase(it, projectiles.end());
+Entity Map::spawn(const EntitySpawn &description) {
+  const SDL_FRect &bounds = description.bounds;
+  const Entity entity = registry.create();
+  registry.transforms.add(entity, {bounds.x, bounds.y, bounds.w, bounds.h});
+  registry.colliders.add(entity, {0.0f, 0.0f, bounds.w, bounds.h});
+  registry.sprites.add(entity,
+                       {description.texture, description.src, 0.0f});
+
+  if (description.kind == EntitySpawn::Kind::COIN) {
+    registry.timers.add(entity, {0.0f});
+    registry.pickups.add(entity, {COIN_BOB_AMPLITUDE, COIN_BOB_FREQUENCY});
+  } else {
+    registry.velocities.add(entity,
+                            {description.velocityX, description.velocityY});
+    registry.hazards.add(entity, {bounds.x, bounds.y});
+  }
+  return entity;
 }
 
-void Map::renderLayer(SDL_Renderer *renderer, int index) const {
+void Map::renderLayer(RenderSnapshot &snapshot, int index) const {
   if (auto layer = getLayer(index)) {
-    layer->render(renderer);
+    layer->render(snapshot, &tileAnimator);
   }
 }
 
 void Map::updateDisappearingPlatforms(float dt) {
-  for (auto &platform : disappearingPlatforms) {
-    platform->update(dt);
-  }
+  // Platform state machines are independent of each other
+  forEachEntity(disappearingPlatforms.size(), [&](size_t begin, size_t end) {
+    for (size_t i = begin; i < end; ++i) {
+      disappearingPlatforms[i]->update(dt);
+    }
+  });
 }
 
 void Map::removeDisappearedPlatforms() {
@@ -497,44 +827,33 @@ void Map::resetCoins() {
   // Reset collected coin count
   collectedCoins = 0;
 
-  // Remove all existing coin projectiles
-  auto it = std::remove_if(projectiles.begin(), projectiles.end(),
-                           [](const std::shared_ptr<Projectile> &proj) {
-                             return proj->getProjectileType() ==
-                                    Projectile::ProjectileType::COIN;
-                           });
-  projectiles.erase(it, projectiles.end());
-
-  // Recreate coins at original positions using stored template data
-  if (originalCoinBounds.size() != static_cast<size_t>(totalCoins)) {
-    std::cerr
-        << "Warning: Mismatch between totalCoins and originalCoinBounds size"
-        << std::endl;
-    return;
+  // Collected coins were only disabled: bring every one back as spawned.
+  // Coins of evicted chunks come back when they are streamed in again.
+  collectedCoinTiles.clear();
+  auto &pickups = registry.pickups;
+  for (size_t i = 0; i < pickups.size(); ++i) {
+    const Entity coin = pickups.entityAt(i);
+    registry.setActive(coin, true);
+    if (Component::Timer *timer = registry.timers.find(coin))
+      timer->time = 0.0f;
   }
+}
 
-  if (!coinTexture) {
-    std::cerr << "Warning: No coin texture stored for respawning" << std::endl;
-    return;
+void Map::saveState(StateWriter &out) const {
+  out.write(collectedCoins);
+  registry.saveState(out);
+  for (const auto &platform : disappearingPlatforms) {
+    platform->saveState(out);
   }
+}
 
-  for (size_t i = 0; i < originalCoinBounds.size(); ++i) {
-    // Use the exact original bounds (position and size)
-    SDL_FRect bounds = originalCoinBounds[i];
-
-    auto coin = std::make_shared<Projectile>(
-        bounds, Projectile::ProjectileType::COIN, coinTexture);
-
-    // Set sprite properties using stored template data
-    auto spriteShared = std::make_shared<Sprite>(coinTexture.get());
-    spriteShared->setSrcRect(coinSrcRect);
-    spriteShared->setDestRect(bounds);
-    coin->setSprite(spriteShared);
-
-    // Set audio manager for coin sound
-    coin->setAudioManager(audioManager);
-
-    // Add coin back to projectiles
-    projectiles.push_back(coin);
+void Map::loadState(StateReader &in) {
+  in.read(collectedCoins);
+  registry.loadState(in);
+  for (const auto &platform : disappearingPlatforms) {
+    platform->loadState(in);
   }
+
+  // Sprite offsets follow from the restored timers
+  EntitySystems::animate(registry, 0.0f, nullptr);
 }
@@ -0,0 +1,163 @@
+#include "../include/particle_system.h"
+#include <algorithm>
+#include <cmath>
+
+namespace {
+
+float lerp(float from, float to, float t) { return from + (to - from) * t; }
+
+Uint8 lerp(Uint8 from, Uint8 to, float t) {
+  return static_cast<Uint8>(lerp(static_cast<float>(from),
+                                 static_cast<float>(to), t) +
+                            0.5f);
+}
+
+} // namespace
+
+ParticleSystem::Pool ParticleSystem::addPool(const ParticleEmitter &emitter,
+                                             SDL_Texture *texture,
+                                             const SDL_Rect &src,
+                                             size_t capacity) {
+  Particles particles;
+  particles.emitter = emitter;
+  particles.texture = texture;
+  particles.src = src;
+  for (auto *field : {&particles.x, &particles.y, &particles.velX,
+                      &particles.velY, &particles.age, &particles.ageRate}) {
+    field->resize(capacity);
+  }
+
+  const Pool pool = pools.size();
+  pools.push_back(std::move(particles));
+
+  // Keep pools of the same texture together so they share a batch
+  auto sameTexture = std::find_if(
+      drawOrder.rbegin(), drawOrder.rend(),
+      [&](Pool other) { return pools[other].texture == texture; });
+  drawOrder.insert(sameTexture == drawOrder.rend() ? drawOrder.end()
+                                                   : sameTexture.base(),
+                   pool);
+  return pool;
+}
+
+void ParticleSystem::emit(Pool pool, float x, float y) {
+  emit(pool, x, y, pools[pool].emitter.angle);
+}
+
+void ParticleSystem::emit(Pool pool, float x, float y, float angle) {
+  Particles &particles = pools[pool];
+  const ParticleEmitter &emitter = particles.emitter;
+  const size_t capacity = particles.x.size();
+  const size_t burst = std::min(static_cast<size_t>(std::max(0, emitter.count)),
+                                capacity - particles.count);
+
+  for (size_t n = 0; n < burst; ++n) {
+    const size_t i = particles.count++;
+    const float direction =
+        angle + random(-emitter.spread / 2, emitter.spread / 2);
+    const float speed = random(emitter.speedMin, emitter.speedMax);
+    const float life = random(emitter.lifeMin, emitter.lifeMax);
+    particles.x[i] = x;
+    particles.y[i] = y;
+    particles.velX[i] = std::cos(direction) * speed;
+    particles.velY[i] = std::sin(direction) * speed;
+    particles.age[i] = 0.0f;
+    particles.ageRate[i] = life > 0.0f ? 1.0f / life : 1.0f;
+  }
+}
+
+void ParticleSystem::update(float dt) {
+  for (Particles &particles : pools) {
+    const size_t count = particles.count;
+    const float damping = std::max(0.0f, 1.0f - particles.emitter.drag * dt);
+    const float fall = particles.emitter.gravity * dt;
+    float *x = particles.x.data();
+    float *y = particles.y.data();
+    float *velX = particles.velX.data();
+    float *velY = particles.velY.data();
+    float *age = particles.age.data();
+    float *ageRate = particles.ageRate.data();
+
+    // Separate straight loops over single arrays vectorize well
+    for (size_t i = 0; i < count; ++i) {
+      velX[i] *= damping;
+      velY[i] = velY[i] * damping + fall;
+    }
+    for (size_t i = 0; i < count; ++i) {
+      x[i] += velX[i] * dt;
+      y[i] += velY[i] * dt;
+    }
+    for (size_t i = 0; i < count; ++i) {
+      age[i] += ageRate[i] * dt;
+    }
+
+    // Retire the dead by moving the last live particle into their slot
+    size_t live = count;
+    for (size_t i = 0; i < live;) {
+      if (age[i] < 1.0f) {
+        ++i;
+        continue;
+      }
+      --live;
+      x[i] = x[live];
+      y[i] = y[live];
+      velX[i] = velX[live];
+      velY[i] = velY[live];
+      age[i] = age[live];
+      ageRate[i] = ageRate[live];
+    }
+    particles.count = live;
+  }
+}
+
+void ParticleSystem::render(RenderSnapshot &snapshot) const {
+  for (Pool pool : drawOrder) {
+    const Particles &particles = pools[pool];
+    if (particles.count == 0 || !particles.texture)
+      continue;
+
+    auto &batches = snapshot.particleBatches;
+    if (batches.empty() || batches.back().texture != particles.texture) {
+      batches.push_back(RenderSnapshot::ParticleBatch{
+          particles.texture, snapshot.particles.size(), 0});
+    }
+
+    const ParticleEmitter &emitter = particles.emitter;
+    for (size_t i = 0; i < particles.count; ++i) {
+      const float t = particles.age[i];
+      const float size = lerp(emitter.sizeStart, emitter.sizeEnd, t);
+      const SDL_Color color = {
+          lerp(emitter.colorStart.r, emitter.colorEnd.r, t),
+          lerp(emitter.colorStart.g, emitter.colorEnd.g, t),
+          lerp(emitter.colorStart.b, emitter.colorEnd.b, t),
+          lerp(emitter.colorStart.a, emitter.colorEnd.a, t)};
+      snapshot.particles.push_back(RenderSnapshot::ParticleQuad{
+          {particles.x[i] - size / 2, particles.y[i] - size / 2, size, size},
+          particles.src,
+          color});
+    }
+    batches.back().count += particles.count;
+  }
+}
+
+void ParticleSystem::clear() {
+  for (Particles &particles : pools) {
+    particles.count = 0;
+  }
+}
+
+size_t ParticleSystem::size() const {
+  size_t count = 0;
+  for (const Particles &particles : pools) {
+    count += particles.count;
+  }
+  return count;
+}
+
+float ParticleSystem::random(float min, float max) {
+  randomState ^= randomState << 13;
+  randomState ^= randomState >> 17;
+  randomState ^= randomState << 5;
+  return min + (max - min) * static_cast<float>(randomState >> 8) /
+                   static_cast<float>(1u << 24);
+}
@@ -1,6 +1,35 @@
 #include "../include/player.h"
 #include <iostream>
 
+namespace {
+
+// Frame at a cell of the player sprite sheet
+constexpr SDL_Rect sheetFrame(int column, int row) {
+  return {SPRITE_SHEET_TILE_WIDTH * column, SPRITE_SHEET_TILE_HEIGHT * row,
+          SPRITE_SHEET_TILE_WIDTH, SPRITE_SHEET_TILE_HEIGHT};
+}
+
+constexpr float FRAME_SECONDS = ANIMATION_FRAME_TIME / 1000.0f;
+
+constexpr SDL_Rect IDLE_FRAMES[] = {sheetFrame(0, 1)};
+constexpr SDL_Rect MOVING_FRAMES[] = {sheetFrame(1, 1), sheetFrame(2, 1),
+                                      sheetFrame(3, 1), sheetFrame(4, 1)};
+constexpr SDL_Rect JUMPING_FRAMES[] = {sheetFrame(9, 1)};
+constexpr SDL_Rect CROUCHING_FRAMES[] = {sheetFrame(7, 1)};
+
+constexpr AnimationClip IDLE_CLIP = AnimationClip::of(IDLE_FRAMES,
+                                                      FRAME_SECONDS);
+constexpr AnimationClip MOVING_CLIP = AnimationClip::of(MOVING_FRAMES,
+                                                        FRAME_SECONDS);
+constexpr AnimationClip JUMPING_CLIP = AnimationClip::of(JUMPING_FRAMES,
+                                                         FRAME_SECONDS);
+constexpr AnimationClip CROUCHING_CLIP = AnimationClip::of(CROUCHING_FRAMES,
+                                                           FRAME_SECONDS);
+
+size_t clipIndex(MovementState state) { return static_cast<size_t>(state); }
+
+} // namespace
+
 RectPlayer::RectPlayer(SDL_FRect rect_in, std::shared_ptr<Texture> texture)
     : texture(texture), sprite(nullptr), rect(rect_in),
       pos_x(static_cast<float>(rect_in.x)),
@@ -24,26 +53,6 @@ void RectPlayer::init() {
   sprite->setDestRect(
       {pos_x, pos_y, static_cast<float>(rect.w), static_cast<float>(rect.h)});
 
-  // Initialize animation frames using config constants
-  animations = {{MovementState::IDLE,
-                 {{SPRITE_SHEET_TILE_WIDTH * 0, SPRITE_SHEET_TILE_HEIGHT * 1,
-                   SPRITE_SHEET_TILE_WIDTH, SPRITE_SHEET_TILE_HEIGHT}}},
-                {MovementState::MOVING,
-                 {{SPRITE_SHEET_TILE_WIDTH * 1, SPRITE_SHEET_TILE_HEIGHT * 1,
-                   SPRITE_SHEET_TILE_WIDTH, SPRITE_SHEET_TILE_HEIGHT},
-                  {SPRITE_SHEET_TILE_WIDTH * 2, SPRITE_SHEET_TILE_HEIGHT * 1,
-                   SPRITE_SHEET_TILE_WIDTH, SPRITE_SHEET_TILE_HEIGHT},
-                  {SPRITE_SHEET_TILE_WIDTH * 3, SPRITE_SHEET_TILE_HEIGHT * 1,
-                   SPRITE_SHEET_TILE_WIDTH, SPRITE_SHEET_TILE_HEIGHT},
-                  {SPRITE_SHEET_TILE_WIDTH * 4, SPRITE_SHEET_TILE_HEIGHT * 1,
-                   SPRITE_SHEET_TILE_WIDTH, SPRITE_SHEET_TILE_HEIGHT}}},
-                {MovementState::JUMPING,
-                 {{SPRITE_SHEET_TILE_WIDTH * 9, SPRITE_SHEET_TILE_HEIGHT * 1,
-                   SPRITE_SHEET_TILE_WIDTH, SPRITE_SHEET_TILE_HEIGHT}}},
-                {MovementState::CROUCHING,
-                 {{SPRITE_SHEET_TILE_WIDTH * 7, SPRITE_SHEET_TILE_HEIGHT * 1,
-                   SPRITE_SHEET_TILE_WIDTH, SPRITE_SHEET_TILE_HEIGHT}}}};
-
   initializeDashParams();
 }
 
@@ -65,47 +74,37 @@ std::pair<float, float> RectPlayer::getVel() const { return {vel_x, vel_y}; }
 
 Sprite *RectPlayer::getSprite() const { return sprite.get(); }
 
-void RectPlayer::setAnimation(const std::vector<SDL_Rect> &frames,
-                              float frameTime) {
+void RectPlayer::setAnimation(const AnimationClip &clip) {
   if (sprite) {
-    sprite->setFrames(frames, frameTime, true);
+    sprite->setClip(&clip);
     sprite->play();
   }
 }
 
 void RectPlayer::animationHandle() {
   if (sprite) {
-    sprite->setFrames(animations[state], ANIMATION_FRAME_TIME / 1000.0f, true);
+    sprite->setClip((*animations)[clipIndex(state)]);
     sprite->play();
   }
 }
 
-void RectPlayer::renderAnimation(SDL_Renderer *renderer, float dt,
-                                 bool boundingBox) const {
+void RectPlayer::updateAnimation(float dt) {
   if (!sprite) {
-    throw std::runtime_error("Sprite is null, cannot render animation");
+    throw std::runtime_error("Sprite is null, cannot update animation");
   }
   sprite->update(dt);
-
-  SDL_RendererFlip flip =
-      (lastDirection == -1) ? SDL_FLIP_HORIZONTAL : SDL_FLIP_NONE;
-  sprite->render(renderer, flip);
-
-  if (boundingBox) {
-    auto bb = getCollisionBounds();
-    SDL_SetRenderDrawColor(renderer, 0, 255, 0, 255);
-    SDL_RenderDrawRectF(renderer, &bb);
-  }
 }
 
-void RectPlayer::SetAnimationMap(
-    std::unordered_map<MovementState, std::vector<SDL_Rect>> anims) {
-  animations = std::move(anims);
+void RectPlayer::setAnimations(const MovementClips &clips) {
+  animations = &clips;
 }
 
-std::unordered_map<MovementState, std::vector<SDL_Rect>>
-RectPlayer::getAnimationMap() const {
-  return animations;
+const MovementClips &RectPlayer::getAnimations() const { return *animations; }
+
+const MovementClips &RectPlayer::defaultAnimations() {
+  static const MovementClips clips = {&IDLE_CLIP, &MOVING_CLIP, &JUMPING_CLIP,
+                                      &CROUCHING_CLIP};
+  return clips;
 }
 
 void RectPlayer::handleMovement(float dt, bool moveLeft, bool moveRight,
@@ -215,34 +214,30 @@ void RectPlayer::update(float dt) {
     float dashVelX =
         (dashDirection == Direction::RIGHT) ? dashSpeed : -dashSpeed;
     pos_x += dashVelX * dt;
-    if (!onGround) {
-      pos_y += gravity * dt; // Still apply gravity during dash if airborne
-    }
+    pos_y += gravity * dt; // Gravity still applies during a dash
   } else {
-    // Normal movement
+    // Normal movement. Gravity keeps pressing into the ground; the tile
+    // mover stops it there and reports the contact.
     pos_x += vel_x * dt;
-    if (onGround) {
-      vel_y = (vel_y > 0) ? 0 : vel_y; // Don't fall through ground
-    }
     pos_y += vel_y;
   }
 
-  // Clamp player position to map boundaries
-  float mapWidth = DEFAULT_MAP_WIDTH * DEFAULT_TILE_WIDTH;
-  float mapHeight = DEFAULT_MAP_HEIGHT * DEFAULT_TILE_HEIGHT;
+  // Clamp player position to the world bounds
+  const float left = worldBounds.x;
+  const float right = worldBounds.x + worldBounds.w;
 
   // Prevent going outside left/right boundaries
-  if (pos_x < 0) {
-    pos_x = 0;
+  if (pos_x < left) {
+    pos_x = left;
     vel_x = 0; // Stop horizontal movement when hitting boundary
-  } else if (pos_x + rect.w > mapWidth) {
-    pos_x = mapWidth - rect.w;
+  } else if (pos_x + rect.w > right) {
+    pos_x = right - rect.w;
     vel_x = 0; // Stop horizontal movement when hitting boundary
   }
 
   // Prevent going above the map (but allow falling below for death/respawn)
-  if (pos_y < 0) {
-    pos_y = 0;
+  if (pos_y < worldBounds.y) {
+    pos_y = worldBounds.y;
     vel_y = 0; // Stop upward movement when hitting top boundary
   }
 
@@ -262,9 +257,17 @@ void RectPlayer::update(float dt) {
   }
 }
 
-void RectPlayer::render(SDL_Renderer *renderer) const {
-  if (sprite && renderer) {
-    sprite->render(renderer);
+void RectPlayer::render(RenderSnapshot &snapshot, bool boundingBox) const {
+  if (!sprite) {
+    throw std::runtime_error("Sprite is null, cannot render animation");
+  }
+
+  SDL_RendererFlip flip =
+      (lastDirection == -1) ? SDL_FLIP_HORIZONTAL : SDL_FLIP_NONE;
+  sprite->render(snapshot, flip);
+
+  if (boundingBox) {
+    snapshot.outlines.push_back(getCollisionBounds());
   }
 }
 
@@ -274,6 +277,10 @@ void RectPlayer::setGravity(float g) { gravity = g; }
 
 void RectPlayer::stopFalling() { vel_y = 0.0f; }
 
+void RectPlayer::setWorldBounds(const SDL_FRect &bounds) {
+  worldBounds = bounds;
+}
+
 void RectPlayer::resetJump() {
   jumpTimer = 0.f;
   isJumping = false;
@@ -436,8 +443,84 @@ void RectPlayer::setPos(float x, float y) {
     sprite->setPosition(x, y);
 }
 
+void RectPlayer::saveState(StateWriter &out) const {
+  out.write(state);
+  out.write(previousState);
+  out.write(rect);
+  out.write(pos_x);
+  out.write(pos_y);
+  out.write(vel_x);
+  out.write(vel_y);
+  out.write(gravity);
+  out.write(onGround);
+  out.write(isJumping);
+  out.write(jumpDuration);
+  out.write(jumpTimer);
+  out.write(lastDirection);
+  out.write(crouching);
+  out.write(dashing);
+  out.write(dashSpeed);
+  out.write(dashDuration);
+  out.write(dashTimer);
+  out.write(dashCooldown);
+  out.write(dashCooldownTimer);
+  out.write(dashDirection);
+  out.write(isSlowed);
+  out.write(isDead);
+
+  // Fields one by one: the struct has padding
+  const Sprite::Playback playback =
+      sprite ? sprite->getPlayback() : Sprite::Playback{0, 0.0f, false};
+  out.write(playback.frame);
+  out.write(playback.timer);
+  out.write(playback.playing);
+}
+
+void RectPlayer::loadState(StateReader &in) {
+  const MovementState animatedState = state;
+  in.read(state);
+  in.read(previousState);
+  in.read(rect);
+  in.read(pos_x);
+  in.read(pos_y);
+  in.read(vel_x);
+  in.read(vel_y);
+  in.read(gravity);
+  in.read(onGround);
+  in.read(isJumping);
+  in.read(jumpDuration);
+  in.read(jumpTimer);
+  in.read(lastDirection);
+  in.read(crouching);
+  in.read(dashing);
+  in.read(dashSpeed);
+  in.read(dashDuration);
+  in.read(dashTimer);
+  in.read(dashCooldown);
+  in.read(dashCooldownTimer);
+  in.read(dashDirection);
+  in.read(isSlowed);
+  in.read(isDead);
+
+  Sprite::Playback playback{0, 0.0f, false};
+  in.read(playback.frame);
+  in.read(playback.timer);
+  in.read(playback.playing);
+  if (sprite) {
+    // Switch the frames only if the restored state animates differently
+    if (state != animatedState)
+      animationHandle();
+    sprite->setPlayback(playback);
+    sprite->setPosition(pos_x, pos_y);
+  }
+}
+
 void RectPlayer::onCollision(Collideable *other, float normalX, float normalY,
                              float penetration) {
+  applyContact(normalX, normalY);
+}
+
+void RectPlayer::applyContact(float normalX, float normalY) {
   if (std::abs(normalY) > 0.5f) {
     if (normalY < 0.f) {
       vel_y = 0.f;
@@ -0,0 +1,56 @@
+#include "../include/render_cache.h"
+#include <iostream>
+
+RenderCache::RenderCache(SDL_Renderer *renderer, int width, int height,
+                         bool transparent)
+    : renderer(renderer), width(width), height(height),
+      transparent(transparent), texture(nullptr, [](SDL_Texture *tex) {
+        if (tex)
+          SDL_DestroyTexture(tex);
+      }) {}
+
+void RenderCache::release() {
+  texture.reset();
+  valid = false;
+}
+
+bool RenderCache::beginRedraw() {
+  if (!renderer || !SDL_RenderTargetSupported(renderer))
+    return false;
+
+  if (!texture) {
+    texture.reset(SDL_CreateTexture(renderer, SDL_PIXELFORMAT_RGBA8888,
+                                    SDL_TEXTUREACCESS_TARGET, width, height));
+    if (!texture) {
+      std::cerr << "Failed to create render cache: " << SDL_GetError()
+                << std::endl;
+      return false;
+    }
+    SDL_SetTextureBlendMode(texture.get(), transparent ? SDL_BLENDMODE_BLEND
+                                                       : SDL_BLENDMODE_NONE);
+  }
+
+  previousTarget = SDL_GetRenderTarget(renderer);
+  if (SDL_SetRenderTarget(renderer, texture.get()) != 0) {
+    std::cerr << "Failed to draw into render cache: " << SDL_GetError()
+              << std::endl;
+    return false;
+  }
+
+  // Start from fully transparent so blended content keeps its alpha
+  SDL_SetRenderDrawBlendMode(renderer, SDL_BLENDMODE_NONE);
+  SDL_SetRenderDrawColor(renderer, 0, 0, 0, 0);
+  SDL_RenderClear(renderer);
+  return true;
+}
+
+void RenderCache::endRedraw() {
+  SDL_SetRenderTarget(renderer, previousTarget);
+  previousTarget = nullptr;
+  valid = true;
+}
+
+void RenderCache::present() {
+  const SDL_Rect target = {0, 0, width, height};
+  SDL_RenderCopy(renderer, texture.get(), nullptr, &target);
+}
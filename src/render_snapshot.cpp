@@ -0,0 +1,78 @@
+#include "../include/render_snapshot.h"
+#include "../include/config.h"
+
+void RenderSnapshot::draw(SDL_Renderer *renderer) const {
+  if (!renderer)
+    return;
+
+  for (const SpriteDraw &sprite : sprites) {
+    // Opacity is per draw: textures are shared between layers
+    if (sprite.alpha != ALPHA_OPAQUE)
+      SDL_SetTextureAlphaMod(sprite.texture, sprite.alpha);
+    SDL_RenderCopyExF(renderer, sprite.texture, &sprite.src, &sprite.dest, 0.0,
+                      nullptr, sprite.flip);
+    if (sprite.alpha != ALPHA_OPAQUE)
+      SDL_SetTextureAlphaMod(sprite.texture, ALPHA_OPAQUE);
+  }
+
+  drawParticles(renderer);
+
+  if (!outlines.empty()) {
+    SDL_SetRenderDrawColor(renderer, 0, 255, 0, 255);
+    for (const SDL_FRect &outline : outlines) {
+      SDL_RenderDrawRectF(renderer, &outline);
+    }
+  }
+}
+
+void RenderSnapshot::drawParticles(SDL_Renderer *renderer) const {
+  for (const ParticleBatch &batch : particleBatches) {
+    const ParticleQuad *quads = particles.data() + batch.first;
+
+#if SDL_VERSION_ATLEAST(2, 0, 18)
+    int width = 0, height = 0;
+    if (SDL_QueryTexture(batch.texture, nullptr, nullptr, &width, &height) !=
+            0 ||
+        width <= 0 || height <= 0)
+      continue;
+
+    // Two triangles per quad, the whole batch in one draw call
+    const float u = 1.0f / width, v = 1.0f / height;
+    vertices.clear();
+    for (size_t i = 0; i < batch.count; ++i) {
+      const ParticleQuad &quad = quads[i];
+      const float left = quad.dest.x, top = quad.dest.y;
+      const float right = left + quad.dest.w, bottom = top + quad.dest.h;
+      const float u0 = quad.src.x * u, v0 = quad.src.y * v;
+      const float u1 = (quad.src.x + quad.src.w) * u;
+      const float v1 = (quad.src.y + quad.src.h) * v;
+      vertices.push_back(SDL_Vertex{{left, top}, quad.color, {u0, v0}});
+      vertices.push_back(SDL_Vertex{{right, top}, quad.color, {u1, v0}});
+      vertices.push_back(SDL_Vertex{{right, bottom}, quad.color, {u1, v1}});
+      vertices.push_back(SDL_Vertex{{left, bottom}, quad.color, {u0, v1}});
+    }
+
+    // The index pattern never changes; only grow it
+    for (size_t quad = indices.size() / 6; quad < batch.count; ++quad) {
+      const int base = static_cast<int>(quad * 4);
+      indices.insert(indices.end(),
+                     {base, base + 1, base + 2, base, base + 2, base + 3});
+    }
+
+    SDL_RenderGeometry(renderer, batch.texture, vertices.data(),
+                       static_cast<int>(vertices.size()), indices.data(),
+                       static_cast<int>(batch.count * 6));
+#else
+    // No geometry API: one copy per particle
+    for (size_t i = 0; i < batch.count; ++i) {
+      const ParticleQuad &quad = quads[i];
+      SDL_SetTextureColorMod(batch.texture, quad.color.r, quad.color.g,
+                             quad.color.b);
+      SDL_SetTextureAlphaMod(batch.texture, quad.color.a);
+      SDL_RenderCopyF(renderer, batch.texture, &quad.src, &quad.dest);
+    }
+    SDL_SetTextureColorMod(batch.texture, 255, 255, 255);
+    SDL_SetTextureAlphaMod(batch.texture, ALPHA_OPAQUE);
+#endif
+  }
+}
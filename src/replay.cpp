@@ -0,0 +1,141 @@
+#include "../include/replay.h"
+#include "../include/vfs.h"
+#include <cstring>
+#include <iostream>
+#include <memory>
+
+namespace {
+
+// File layout, all little-endian:
+//   "RBRP" | version | tick rate | map hash | tick count | run count
+//   runs: input (u16), length (u32)
+//   tick count state hashes (u32)
+const char MAGIC[4] = {'R', 'B', 'R', 'P'};
+constexpr Uint32 VERSION = 2; // 2: 16-bit inputs
+
+using FilePtr = std::unique_ptr<SDL_RWops, int (*)(SDL_RWops *)>;
+
+} // namespace
+
+Replay::Replay(int tickRate, Uint32 mapHash)
+    : tickRate(tickRate), mapHash(mapHash) {}
+
+void Replay::record(Uint16 input, Uint32 stateHash) {
+  inputs.push_back(input);
+  hashes.push_back(stateHash);
+}
+
+bool Replay::save(const std::string &path) const {
+  FilePtr file(SDL_RWFromFile(path.c_str(), "wb"), SDL_RWclose);
+  if (!file) {
+    std::cerr << "Cannot write replay " << path << ": " << SDL_GetError()
+              << std::endl;
+    return false;
+  }
+
+  // Collapse the inputs into runs first; the count goes in the header
+  std::vector<std::pair<Uint16, Uint32>> runs;
+  for (Uint16 input : inputs) {
+    if (!runs.empty() && runs.back().first == input)
+      ++runs.back().second;
+    else
+      runs.emplace_back(input, 1);
+  }
+
+  bool ok = SDL_RWwrite(file.get(), MAGIC, sizeof(MAGIC), 1) == 1;
+  ok = ok && SDL_WriteLE32(file.get(), VERSION) == 1;
+  ok = ok && SDL_WriteLE32(file.get(), static_cast<Uint32>(tickRate)) == 1;
+  ok = ok && SDL_WriteLE32(file.get(), mapHash) == 1;
+  ok = ok && SDL_WriteLE32(file.get(), static_cast<Uint32>(tickCount())) == 1;
+  ok = ok && SDL_WriteLE32(file.get(), static_cast<Uint32>(runs.size())) == 1;
+  for (const auto &run : runs) {
+    ok = ok && SDL_WriteLE16(file.get(), run.first) == 1;
+    ok = ok && SDL_WriteLE32(file.get(), run.second) == 1;
+  }
+  for (Uint32 stateHash : hashes) {
+    ok = ok && SDL_WriteLE32(file.get(), stateHash) == 1;
+  }
+
+  if (!ok) {
+    std::cerr << "Failed writing replay " << path << ": " << SDL_GetError()
+              << std::endl;
+    return false;
+  }
+  std::cout << "Saved replay " << path << " (" << tickCount() << " ticks, "
+            << runs.size() << " input runs)" << std::endl;
+  return true;
+}
+
+bool Replay::load(const std::string &path) {
+  FilePtr file(SDL_RWFromFile(path.c_str(), "rb"), SDL_RWclose);
+  if (!file) {
+    std::cerr << "Cannot open replay " << path << ": " << SDL_GetError()
+              << std::endl;
+    return false;
+  }
+
+  auto invalid = [&](const char *reason) {
+    std::cerr << "Invalid replay " << path << ": " << reason << std::endl;
+    *this = Replay();
+    return false;
+  };
+
+  char magic[sizeof(MAGIC)];
+  if (SDL_RWread(file.get(), magic, sizeof(magic), 1) != 1 ||
+      std::memcmp(magic, MAGIC, sizeof(MAGIC)) != 0)
+    return invalid("bad magic");
+  if (SDL_ReadLE32(file.get()) != VERSION)
+    return invalid("unsupported version");
+
+  // Reads past the end return 0, so sizes are checked against the file
+  const Sint64 fileSize = SDL_RWsize(file.get());
+  tickRate = static_cast<int>(SDL_ReadLE32(file.get()));
+  mapHash = SDL_ReadLE32(file.get());
+  const Uint32 ticks = SDL_ReadLE32(file.get());
+  const Uint32 runCount = SDL_ReadLE32(file.get());
+  const Sint64 expected = 24 + Sint64(runCount) * 6 + Sint64(ticks) * 4;
+  if (tickRate <= 0 || fileSize != expected)
+    return invalid("truncated or corrupt");
+  if (ticks == 0)
+    return invalid("empty replay");
+
+  inputs.clear();
+  inputs.reserve(ticks);
+  for (Uint32 i = 0; i < runCount; ++i) {
+    const Uint16 input = SDL_ReadLE16(file.get());
+    const Uint32 length = SDL_ReadLE32(file.get());
+    if (length > ticks - inputs.size())
+      return invalid("input runs longer than the replay");
+    inputs.insert(inputs.end(), length, input);
+  }
+  if (inputs.size() != ticks)
+    return invalid("input runs shorter than the replay");
+
+  hashes.resize(ticks);
+  for (Uint32 &stateHash : hashes) {
+    stateHash = SDL_ReadLE32(file.get());
+  }
+  return true;
+}
+
+Uint32 Replay::hash(const void *data, size_t size, Uint32 hash) {
+  const auto *bytes = static_cast<const unsigned char *>(data);
+  for (size_t i = 0; i < size; ++i) {
+    hash = (hash ^ bytes[i]) * 16777619u; // FNV prime
+  }
+  return hash;
+}
+
+Uint32 Replay::hashResource(const std::string &path) {
+  FilePtr file(Vfs::resources().open(path), SDL_RWclose);
+  if (!file)
+    return 0;
+
+  Uint32 result = HASH_SEED;
+  unsigned char buffer[4096];
+  size_t read;
+  while ((read = SDL_RWread(file.get(), buffer, 1, sizeof(buffer))) > 0) {
+    result = hash(buffer, read, result);
+  }
+  return result;
+}
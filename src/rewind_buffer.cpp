@@ -0,0 +1,106 @@
+#include "../include/rewind_buffer.h"
+#include <algorithm>
+
+// Delta encoding: the state XOR its keyframe, as a sequence of
+//   [zero run length (u8)] [literal length (u8)] [literal bytes]
+// covering the whole state. Runs longer than 255 are split.
+
+RewindBuffer::RewindBuffer(size_t ticks, size_t keyframeInterval)
+    : frames(ticks + std::max<size_t>(keyframeInterval, 1)),
+      keyframeInterval(std::max<size_t>(keyframeInterval, 1)) {}
+
+void RewindBuffer::push(const std::vector<Uint8> &state) {
+  if (size() == frames.size())
+    evictOldest();
+
+  Frame &frame = frameAt(end);
+  frame.bytes.clear();
+
+  // Deltas need a recent keyframe of the same size
+  const Frame *key = nullptr;
+  if (size() > 0) {
+    const Uint64 keyTick = frameAt(end - 1).keyframe;
+    if (end - keyTick < keyframeInterval &&
+        frameAt(keyTick).bytes.size() == state.size()) {
+      key = &frameAt(keyTick);
+      frame.keyframe = keyTick;
+    }
+  }
+
+  if (!key) {
+    frame.bytes.insert(frame.bytes.end(), state.begin(), state.end());
+    frame.keyframe = end;
+    ++end;
+    return;
+  }
+
+  const Uint8 *base = key->bytes.data();
+  const size_t length = state.size();
+  size_t i = 0;
+  while (i < length) {
+    Uint8 zeros = 0;
+    while (i < length && zeros < 255 && state[i] == base[i]) {
+      ++zeros;
+      ++i;
+    }
+    const size_t literalStart = i;
+    Uint8 literals = 0;
+    while (i < length && literals < 255 && state[i] != base[i]) {
+      ++literals;
+      ++i;
+    }
+    frame.bytes.push_back(zeros);
+    frame.bytes.push_back(literals);
+    for (size_t j = literalStart; j < i; ++j) {
+      frame.bytes.push_back(state[j] ^ base[j]);
+    }
+  }
+  ++end;
+}
+
+bool RewindBuffer::restore(size_t ticksBack, std::vector<Uint8> &state) const {
+  if (ticksBack >= size())
+    return false;
+
+  const Uint64 tick = end - 1 - ticksBack;
+  const Frame &frame = frameAt(tick);
+  const Frame &key = frameAt(frame.keyframe);
+  state.assign(key.bytes.begin(), key.bytes.end());
+  if (frame.keyframe == tick)
+    return true;
+
+  // Apply the delta; runs never reach past the keyframe's size
+  size_t position = 0;
+  const std::vector<Uint8> &delta = frame.bytes;
+  for (size_t r = 0; r + 1 < delta.size();) {
+    position += delta[r];
+    const size_t literals = delta[r + 1];
+    r += 2;
+    for (size_t j = 0; j < literals; ++j) {
+      state[position++] ^= delta[r++];
+    }
+  }
+  return true;
+}
+
+void RewindBuffer::drop(size_t ticks) {
+  end -= std::min<size_t>(ticks, size());
+}
+
+void RewindBuffer::clear() { first = end = 0; }
+
+size_t RewindBuffer::storedBytes() const {
+  size_t total = 0;
+  for (Uint64 tick = first; tick < end; ++tick) {
+    total += frameAt(tick).bytes.size();
+  }
+  return total;
+}
+
+void RewindBuffer::evictOldest() {
+  // The oldest stored tick is always a keyframe
+  const Uint64 keyTick = first;
+  do {
+    ++first;
+  } while (first < end && frameAt(first).keyframe == keyTick);
+}
@@ -1,4 +1,6 @@
 #include "../include/sprite.h"
+#include "../include/render_snapshot.h"
+#include <algorithm>
 #include <cassert>
 
 Sprite::Sprite(Texture *tex) : texture(tex) {
@@ -25,11 +27,23 @@ int Sprite::render(SDL_Renderer *renderer,
                            activeFlip);
 }
 
+void Sprite::render(RenderSnapshot &snapshot, SDL_RendererFlip flipOverride,
+                    Uint8 alpha) const {
+  if (!visible || !texture || !texture->get()) {
+    return;
+  }
+
+  SDL_RendererFlip activeFlip =
+      (flipOverride != SDL_FLIP_NONE) ? flipOverride : flip;
+  snapshot.sprites.push_back(
+      RenderSnapshot::SpriteDraw{texture->get(), src, dest, activeFlip, alpha});
+}
+
 void Sprite::setSrcRect(const SDL_Rect &rect) {
   src = rect;
-  // Clear animation frames when manually setting source rect
+  // Drop the clip when manually setting source rect
   // This prevents conflicts between manual rect setting and animation
-  frames.clear();
+  clip = nullptr;
   playing = false;
 }
 
@@ -45,7 +59,7 @@ void Sprite::changeTexture(Texture *tex) {
   texture = tex;
   // Reset animation state when changing texture
   // New texture may have different dimensions or frame layout
-  frames.clear();
+  clip = nullptr;
   playing = false;
   currentFrame = 0;
   frameTimer = 0.0f;
@@ -79,26 +93,25 @@ void Sprite::scale(float factor_w, float factor_h) {
   dest.h *= factor_h;
 }
 
-void Sprite::setFrames(const std::vector<SDL_Rect> &f, float secondsPerFrame,
-                       bool loop) {
-  frames = f;
-  frameDuration = secondsPerFrame;
-  looping = loop;
+void Sprite::setClip(const AnimationClip *animation) {
+  clip = animation && animation->frameCount > 0 ? animation : nullptr;
   currentFrame = 0;
   frameTimer = 0.0f;
 
-  // Start playing if frames are provided
-  playing = !frames.empty();
+  // Start playing if the clip has frames
+  playing = clip != nullptr;
 
   // Set initial frame as source rect
-  if (!frames.empty()) {
-    src = frames[0];
+  if (clip) {
+    src = clip->frames[0];
   }
 }
 
+const AnimationClip *Sprite::getClip() const { return clip; }
+
 void Sprite::play() {
   // Only play if we have frames to animate
-  if (!frames.empty()) {
+  if (clip) {
     playing = true;
   }
 }
@@ -109,16 +122,30 @@ void Sprite::stop() {
   frameTimer = 0.0f;
 
   // Reset to first frame
-  if (!frames.empty()) {
-    src = frames[0];
+  if (clip) {
+    src = clip->frames[0];
+  }
+}
+
+Sprite::Playback Sprite::getPlayback() const {
+  return Playback{static_cast<Uint32>(currentFrame), frameTimer, playing};
+}
+
+void Sprite::setPlayback(const Playback &playback) {
+  frameTimer = playback.timer;
+  playing = playback.playing && clip;
+  if (clip) {
+    currentFrame = std::min<size_t>(playback.frame, clip->frameCount - 1);
+    src = clip->frames[currentFrame];
   }
 }
 
 void Sprite::update(float dt) {
-  // Skip update if not playing, no frames, or invalid frame duration
-  if (!playing || frames.empty() || frameDuration <= 0.0f) {
+  // Skip update if not playing, no clip, or invalid frame duration
+  if (!playing || !clip || clip->frameDuration <= 0.0f) {
     return;
   }
+  const float frameDuration = clip->frameDuration;
 
   // Accumulate delta time
   frameTimer += dt;
@@ -130,20 +157,20 @@ void Sprite::update(float dt) {
     currentFrame++;
 
     // Handle end of animation
-    if (currentFrame >= frames.size()) {
-      if (looping) {
+    if (currentFrame >= clip->frameCount) {
+      if (clip->looping) {
         // Loop back to start
         currentFrame = 0;
       } else {
         // Stop on last frame
-        currentFrame = frames.size() - 1;
+        currentFrame = clip->frameCount - 1;
         playing = false;
         break;
       }
     }
 
     // Update source rect to current frame
-    src = frames[currentFrame];
+    src = clip->frames[currentFrame];
   }
 }
 
@@ -0,0 +1,206 @@
+#include "../include/text_renderer.h"
+#include <algorithm>
+#include <stdexcept>
+#include <string>
+
+namespace {
+
+constexpr int ATLAS_WIDTH = 512;
+constexpr int GLYPH_PADDING = 1; // Keeps filtering from bleeding between cells
+
+using SurfacePtr = std::unique_ptr<SDL_Surface, void (*)(SDL_Surface *)>;
+
+} // namespace
+
+TextRenderer::TextRenderer(SDL_Renderer *renderer, TTF_Font *font)
+    : renderer(renderer), atlas(nullptr, [](SDL_Texture *texture) {
+        if (texture)
+          SDL_DestroyTexture(texture);
+      }) {
+  if (!renderer || !font) {
+    throw std::runtime_error("TextRenderer needs a renderer and a font");
+  }
+
+  glyphHeight = TTF_FontHeight(font);
+  lineHeight = TTF_FontLineSkip(font);
+
+  // Rasterize every glyph white, so vertex colors can tint them
+  const SDL_Color white = {255, 255, 255, 255};
+  std::vector<SurfacePtr> cells;
+  cells.reserve(GLYPH_COUNT);
+  int penX = 0, penY = 0, rowHeight = 0;
+  for (int i = 0; i < GLYPH_COUNT; ++i) {
+    const Uint16 ch = static_cast<Uint16>(FIRST_GLYPH + i);
+    Glyph &glyph = glyphs[i];
+
+    int minX, maxX, minY, maxY;
+    if (TTF_GlyphMetrics(font, ch, &minX, &maxX, &minY, &maxY,
+                         &glyph.advance) != 0) {
+      glyph.advance = 0;
+    }
+
+    SurfacePtr cell(TTF_RenderGlyph_Blended(font, ch, white),
+                    SDL_FreeSurface);
+    if (!cell) {
+      cells.push_back(std::move(cell)); // Not in the font: advance only
+      continue;
+    }
+
+    // Shelf packing: fill rows left to right
+    if (penX + cell->w > ATLAS_WIDTH) {
+      penX = 0;
+      penY += rowHeight + GLYPH_PADDING;
+      rowHeight = 0;
+    }
+    glyph.source = {penX, penY, cell->w, cell->h};
+    penX += cell->w + GLYPH_PADDING;
+    rowHeight = std::max(rowHeight, cell->h);
+    cells.push_back(std::move(cell));
+  }
+  atlasWidth = ATLAS_WIDTH;
+  atlasHeight = std::max(1, penY + rowHeight);
+
+  SurfacePtr sheet(SDL_CreateRGBSurfaceWithFormat(0, atlasWidth, atlasHeight,
+                                                  32, SDL_PIXELFORMAT_RGBA32),
+                   SDL_FreeSurface);
+  if (!sheet) {
+    throw std::runtime_error("Failed to create glyph atlas: " +
+                             std::string(SDL_GetError()));
+  }
+  for (int i = 0; i < GLYPH_COUNT; ++i) {
+    if (!cells[i])
+      continue;
+    // Copy alpha as is instead of blending onto the empty sheet
+    SDL_SetSurfaceBlendMode(cells[i].get(), SDL_BLENDMODE_NONE);
+    SDL_Rect target = glyphs[i].source;
+    SDL_BlitSurface(cells[i].get(), nullptr, sheet.get(), &target);
+  }
+
+  atlas.reset(SDL_CreateTextureFromSurface(renderer, sheet.get()));
+  if (!atlas) {
+    throw std::runtime_error("Failed to upload glyph atlas: " +
+                             std::string(SDL_GetError()));
+  }
+  SDL_SetTextureBlendMode(atlas.get(), SDL_BLENDMODE_BLEND);
+
+  // Kerning pairs, looked up by glyph index
+  if (TTF_GetFontKerning(font)) {
+    kerning.assign(GLYPH_COUNT * GLYPH_COUNT, 0);
+    for (int previous = 0; previous < GLYPH_COUNT; ++previous) {
+      for (int current = 0; current < GLYPH_COUNT; ++current) {
+        kerning[previous * GLYPH_COUNT + current] =
+            static_cast<short>(TTF_GetFontKerningSizeGlyphs(
+                font, static_cast<Uint16>(FIRST_GLYPH + previous),
+                static_cast<Uint16>(FIRST_GLYPH + current)));
+      }
+    }
+  }
+}
+
+int TextRenderer::glyphIndex(char c) {
+  const int code = static_cast<unsigned char>(c);
+  if (code < FIRST_GLYPH || code > LAST_GLYPH)
+    return '?' - FIRST_GLYPH;
+  return code - FIRST_GLYPH;
+}
+
+int TextRenderer::kerningFor(int previous, int current) const {
+  if (kerning.empty() || previous < 0)
+    return 0;
+  return kerning[previous * GLYPH_COUNT + current];
+}
+
+template <typename Visit>
+SDL_Point TextRenderer::layout(const char *text, float scale,
+                               Visit visit) const {
+  SDL_Point size = {0, 0};
+  if (!text || !*text)
+    return size;
+
+  float penX = 0.0f, penY = 0.0f;
+  int previous = -1;
+  for (const char *c = text; *c; ++c) {
+    if (*c == '\n') {
+      size.x = std::max(size.x, static_cast<int>(penX));
+      penX = 0.0f;
+      penY += lineHeight * scale;
+      previous = -1;
+      continue;
+    }
+
+    const int index = glyphIndex(*c);
+    penX += kerningFor(previous, index) * scale;
+    visit(glyphs[index], penX, penY);
+    penX += glyphs[index].advance * scale;
+    previous = index;
+  }
+  size.x = std::max(size.x, static_cast<int>(penX));
+  size.y = static_cast<int>(penY + glyphHeight * scale);
+  return size;
+}
+
+SDL_Point TextRenderer::measure(const char *text, float scale) const {
+  return layout(text, scale, [](const Glyph &, float, float) {});
+}
+
+SDL_Rect TextRenderer::draw(const char *text, int x, int y, SDL_Color color,
+                            float scale) {
+  SDL_Point size =
+      layout(text, scale, [&](const Glyph &glyph, float penX, float penY) {
+        if (glyph.source.w == 0)
+          return; // Blank (e.g. space)
+        quads.push_back(Quad{{x + penX, y + penY, glyph.source.w * scale,
+                              glyph.source.h * scale},
+                             glyph.source,
+                             color});
+      });
+  return SDL_Rect{x, y, size.x, size.y};
+}
+
+SDL_Rect TextRenderer::drawCentered(const char *text, int centerX, int y,
+                                    SDL_Color color, float scale) {
+  return draw(text, centerX - measure(text, scale).x / 2, y, color, scale);
+}
+
+void TextRenderer::flush() {
+  if (quads.empty())
+    return;
+
+#if SDL_VERSION_ATLEAST(2, 0, 18)
+  // Two triangles per quad, all in one draw call
+  const float u = 1.0f / atlasWidth, v = 1.0f / atlasHeight;
+  vertices.clear();
+  for (const Quad &quad : quads) {
+    const float left = quad.target.x, top = quad.target.y;
+    const float right = left + quad.target.w, bottom = top + quad.target.h;
+    const float u0 = quad.source.x * u, v0 = quad.source.y * v;
+    const float u1 = (quad.source.x + quad.source.w) * u;
+    const float v1 = (quad.source.y + quad.source.h) * v;
+    vertices.push_back(SDL_Vertex{{left, top}, quad.color, {u0, v0}});
+    vertices.push_back(SDL_Vertex{{right, top}, quad.color, {u1, v0}});
+    vertices.push_back(SDL_Vertex{{right, bottom}, quad.color, {u1, v1}});
+    vertices.push_back(SDL_Vertex{{left, bottom}, quad.color, {u0, v1}});
+  }
+
+  // The index pattern never changes; only grow it
+  for (size_t quad = indices.size() / 6; quad < quads.size(); ++quad) {
+    const int base = static_cast<int>(quad * 4);
+    indices.insert(indices.end(),
+                   {base, base + 1, base + 2, base, base + 2, base + 3});
+  }
+
+  SDL_RenderGeometry(renderer, atlas.get(), vertices.data(),
+                     static_cast<int>(vertices.size()), indices.data(),
+                     static_cast<int>(quads.size() * 6));
+#else
+  // No geometry API: one copy per glyph, still without allocations
+  for (const Quad &quad : quads) {
+    SDL_SetTextureColorMod(atlas.get(), quad.color.r, quad.color.g,
+                           quad.color.b);
+    SDL_SetTextureAlphaMod(atlas.get(), quad.color.a);
+    SDL_RenderCopyF(renderer, atlas.get(), &quad.source, &quad.target);
+  }
+#endif
+
+  quads.clear();
+}
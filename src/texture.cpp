@@ -1,4 +1,5 @@
 #include "../include/texture.h"
+#include "../include/vfs.h"
 #include <stdexcept>
 #include <string>
 
@@ -17,24 +18,53 @@ Texture::Texture(SDL_Renderer *renderer, const char *filePath)
   }
 
   // Load surface from image file using SDL_image
-  loadedSurface = IMG_Load(filePath);
+  SDL_RWops *source = Vfs::resources().open(filePath);
+  loadedSurface = source ? IMG_Load_RW(source, 1) : nullptr;
   if (!loadedSurface) {
     throw std::runtime_error("Failed to load image: " + std::string(filePath) +
                              " - " + IMG_GetError());
   }
 
-  // Create texture from surface
-  SDL_Texture *newTexture =
-      SDL_CreateTextureFromSurface(renderer, loadedSurface);
-
-  // Free surface immediately - no longer needed after texture creation
+  // Create texture from surface, then free the surface immediately - it is
+  // no longer needed after texture creation
+  try {
+    upload(renderer, loadedSurface, filePath);
+  } catch (...) {
+    SDL_FreeSurface(loadedSurface);
+    loadedSurface = nullptr;
+    throw;
+  }
   SDL_FreeSurface(loadedSurface);
   loadedSurface = nullptr;
+}
+
+Texture::Texture(SDL_Renderer *renderer, SDL_Surface *surface,
+                 const char *name)
+    : loadedSurface(nullptr), texture(nullptr, [](SDL_Texture *tex) {
+        if (tex)
+          SDL_DestroyTexture(tex);
+      }) {
+
+  // Validate input parameters
+  if (!renderer) {
+    throw std::runtime_error("Renderer cannot be null");
+  }
+  if (!surface) {
+    throw std::runtime_error("Surface cannot be null");
+  }
+
+  upload(renderer, surface, name ? name : "<surface>");
+}
+
+void Texture::upload(SDL_Renderer *renderer, SDL_Surface *surface,
+                     const char *name) {
+  // Create texture from surface
+  SDL_Texture *newTexture = SDL_CreateTextureFromSurface(renderer, surface);
 
   // Check if texture creation succeeded
   if (!newTexture) {
     throw std::runtime_error("Failed to create texture from: " +
-                             std::string(filePath) + " - " + SDL_GetError());
+                             std::string(name) + " - " + SDL_GetError());
   }
 
   // Transfer ownership to smart pointer
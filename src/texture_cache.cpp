@@ -0,0 +1,85 @@
+#include "../include/texture_cache.h"
+#include "../include/vfs.h"
+
+TextureCache::TextureCache(SDL_Renderer *renderer)
+    : renderer(renderer), state(std::make_shared<State>()) {}
+
+std::shared_ptr<Texture> TextureCache::load(const std::string &filePath) {
+  return load(filePath, nullptr);
+}
+
+std::shared_ptr<Texture> TextureCache::load(const std::string &filePath,
+                                            SDL_Surface *decoded) {
+  const std::string key = canonicalPath(filePath);
+
+  {
+    std::lock_guard<std::mutex> lock(state->mutex);
+    auto it = state->entries.find(key);
+    if (it != state->entries.end()) {
+      if (auto texture = it->second.texture.lock())
+        return texture;
+    }
+  }
+
+  // Load outside the lock; the deleter of an expiring texture may need it
+  auto *raw = decoded ? new Texture(renderer, decoded, filePath.c_str())
+                     : new Texture(renderer, filePath.c_str());
+
+  size_t bytes = 0;
+  Uint32 format = 0;
+  int w = 0, h = 0;
+  if (SDL_QueryTexture(raw->get(), &format, nullptr, &w, &h) == 0) {
+    bytes = static_cast<size_t>(w) * static_cast<size_t>(h) *
+            static_cast<size_t>(SDL_BYTESPERPIXEL(format));
+  }
+
+  std::weak_ptr<State> weakState = state;
+  std::shared_ptr<Texture> texture(raw, [weakState, key](Texture *tex) {
+    if (auto owner = weakState.lock()) {
+      std::lock_guard<std::mutex> lock(owner->mutex);
+      auto it = owner->entries.find(key);
+      // The entry may already point at a newer texture for the same path
+      if (it != owner->entries.end() && it->second.texture.expired()) {
+        owner->residentBytes -= it->second.bytes;
+        owner->entries.erase(it);
+      }
+    }
+    delete tex;
+  });
+
+  std::lock_guard<std::mutex> lock(state->mutex);
+  Entry &entry = state->entries[key];
+  if (!entry.texture.expired()) {
+    // Another caller won the race; the duplicate is released on return
+    return entry.texture.lock();
+  }
+  state->residentBytes -= entry.bytes;
+  entry.texture = texture;
+  entry.bytes = bytes;
+  state->residentBytes += bytes;
+  return texture;
+}
+
+bool TextureCache::contains(const std::string &filePath) const {
+  return getUseCount(filePath) > 0;
+}
+
+long TextureCache::getUseCount(const std::string &filePath) const {
+  std::lock_guard<std::mutex> lock(state->mutex);
+  auto it = state->entries.find(canonicalPath(filePath));
+  return it == state->entries.end() ? 0 : it->second.texture.use_count();
+}
+
+size_t TextureCache::getTextureCount() const {
+  std::lock_guard<std::mutex> lock(state->mutex);
+  return state->entries.size();
+}
+
+size_t TextureCache::getResidentBytes() const {
+  std::lock_guard<std::mutex> lock(state->mutex);
+  return state->residentBytes;
+}
+
+std::string TextureCache::canonicalPath(const std::string &filePath) {
+  return Vfs::normalize(filePath);
+}
@@ -0,0 +1,70 @@
+#include "../include/tile_animator.h"
+#include "../include/layer.h"
+#include <algorithm>
+#include <cmath>
+
+void TileAnimator::build(const std::vector<TMXParser::TilesetInfo> &tilesets) {
+  clear();
+
+  for (const auto &tileset : tilesets) {
+    if (tileset.columns <= 0)
+      continue;
+
+    for (const auto &tileAnimation : tileset.animations) {
+      Animation animation{tileset.firstGid + tileAnimation.tileId,
+                          frameRects.size(), 0, 0};
+      for (const auto &frame : tileAnimation.frames) {
+        animation.length += static_cast<Uint32>(std::max(0, frame.duration));
+        frameRects.push_back(Layer::tileSrcRect(tileset, frame.tileId));
+        frameEnds.push_back(animation.length);
+        ++animation.frameCount;
+      }
+      animations.push_back(animation);
+    }
+  }
+
+  std::sort(
+      animations.begin(), animations.end(),
+      [](const Animation &a, const Animation &b) { return a.gid < b.gid; });
+
+  current.resize(animations.size());
+  update(0.0f);
+}
+
+void TileAnimator::clear() {
+  animations.clear();
+  frameRects.clear();
+  frameEnds.clear();
+  current.clear();
+  clockMs = 0.0;
+}
+
+int TileAnimator::slotOf(int gid) const {
+  auto it = std::lower_bound(
+      animations.begin(), animations.end(), gid,
+      [](const Animation &animation, int key) { return animation.gid < key; });
+  if (it == animations.end() || it->gid != gid)
+    return -1;
+  return static_cast<int>(it - animations.begin());
+}
+
+void TileAnimator::update(float dt) {
+  clockMs += static_cast<double>(dt) * 1000.0;
+
+  for (size_t slot = 0; slot < animations.size(); ++slot) {
+    const Animation &animation = animations[slot];
+    size_t frame = 0;
+
+    // Zero-length cycles stay on their first frame
+    if (animation.length > 0) {
+      const auto time = static_cast<Uint32>(
+          std::fmod(clockMs, static_cast<double>(animation.length)));
+      // Cycles are a handful of frames; a linear scan beats a search
+      while (frame + 1 < animation.frameCount &&
+             time >= frameEnds[animation.firstFrame + frame]) {
+        ++frame;
+      }
+    }
+    current[slot] = frameRects[animation.firstFrame + frame];
+  }
+}
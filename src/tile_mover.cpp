@@ -0,0 +1,112 @@
+#include "../include/tile_mover.h"
+#include "../include/config.h"
+#include <cmath>
+
+namespace {
+
+// Tile index of a world coordinate (floor, so negatives work)
+int tileOf(float world, int tileSize) {
+  return static_cast<int>(std::floor(world / tileSize));
+}
+
+// Tiles covered by [start, end), shrunk slightly so that edges lying
+// exactly on a tile border don't count the neighbouring tile
+void coveredTiles(float start, float end, int tileSize, int &first,
+                  int &last) {
+  first = tileOf(start + TILE_SWEEP_EPSILON, tileSize);
+  last = tileOf(end - TILE_SWEEP_EPSILON, tileSize);
+}
+
+bool solidColumn(const Map &map, int tx, int firstRow, int lastRow) {
+  for (int ty = firstRow; ty <= lastRow; ++ty) {
+    if (map.isSolid(tx, ty))
+      return true;
+  }
+  return false;
+}
+
+bool solidRow(const Map &map, int ty, int firstColumn, int lastColumn) {
+  for (int tx = firstColumn; tx <= lastColumn; ++tx) {
+    if (map.isSolid(tx, ty))
+      return true;
+  }
+  return false;
+}
+
+} // namespace
+
+Uint8 TileMover::move(const Map &map, SDL_FRect &box, float dx, float dy) {
+  const int tileW = map.getTileWidth();
+  const int tileH = map.getTileHeight();
+  if (tileW <= 0 || tileH <= 0) {
+    box.x += dx;
+    box.y += dy;
+    return NONE;
+  }
+
+  Uint8 contacts = NONE;
+  int first, last;
+
+  // Horizontal: scan the columns the leading edge enters, over the rows
+  // the box spans
+  if (dx != 0.0f) {
+    int firstRow, lastRow;
+    coveredTiles(box.y, box.y + box.h, tileH, firstRow, lastRow);
+
+    if (dx > 0.0f) {
+      coveredTiles(box.x, box.x + box.w, tileW, first, last);
+      const int end = tileOf(box.x + box.w + dx - TILE_SWEEP_EPSILON, tileW);
+      box.x += dx;
+      for (int tx = last + 1; tx <= end; ++tx) {
+        if (solidColumn(map, tx, firstRow, lastRow)) {
+          box.x = static_cast<float>(tx * tileW) - box.w;
+          contacts |= WALL;
+          break;
+        }
+      }
+    } else {
+      coveredTiles(box.x, box.x + box.w, tileW, first, last);
+      const int end = tileOf(box.x + dx + TILE_SWEEP_EPSILON, tileW);
+      box.x += dx;
+      for (int tx = first - 1; tx >= end; --tx) {
+        if (solidColumn(map, tx, firstRow, lastRow)) {
+          box.x = static_cast<float>((tx + 1) * tileW);
+          contacts |= WALL;
+          break;
+        }
+      }
+    }
+  }
+
+  // Vertical, from where the horizontal move ended
+  if (dy != 0.0f) {
+    int firstColumn, lastColumn;
+    coveredTiles(box.x, box.x + box.w, tileW, firstColumn, lastColumn);
+
+    if (dy > 0.0f) {
+      coveredTiles(box.y, box.y + box.h, tileH, first, last);
+      const int end = tileOf(box.y + box.h + dy - TILE_SWEEP_EPSILON, tileH);
+      box.y += dy;
+      for (int ty = last + 1; ty <= end; ++ty) {
+        if (solidRow(map, ty, firstColumn, lastColumn)) {
+          box.y = static_cast<float>(ty * tileH) - box.h;
+          contacts |= GROUND;
+          break;
+        }
+      }
+    } else {
+      coveredTiles(box.y, box.y + box.h, tileH, first, last);
+      const int end = tileOf(box.y + dy + TILE_SWEEP_EPSILON, tileH);
+      box.y += dy;
+      for (int ty = first - 1; ty >= end; --ty) {
+        if (solidRow(map, ty, firstColumn, lastColumn)) {
+          box.y = static_cast<float>((ty + 1) * tileH);
+          contacts |= CEILING;
+          break;
+        }
+      }
+    }
+  }
+
+  return contacts;
+}
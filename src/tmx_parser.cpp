@@ -1,164 +1,95 @@
 #include "../include/tmx_parser.h"
-#include "tinyxml2.h"
-#include <algorithm>
-#include <cctype>
-#include <sstream>
+#include "../include/tmx_reader.h"
+#include <filesystem>
 #include <stdexcept>
 
-using namespace tinyxml2;
+namespace {
 
-TMXParser::TMXParser(const std::string &tmxFilePath)
-    : tmxFilePath(tmxFilePath), doc(std::make_unique<XMLDocument>()),
-      mapElement(nullptr) {}
+// Collects reader events into the parser's storage. Layer data is decoded
+// straight into TMXParser::Layer::data, so nothing is copied after parsing,
+// but a finite map holds every layer's GIDs until Map has built its tiles
+// and calls releaseLayerData(). Chunks of infinite maps are only indexed.
+class CollectingHandler : public TMXReader::Handler {
+public:
+  CollectingHandler(TMXParser::MapInfo &mapInfo,
+                    std::vector<TMXParser::TilesetInfo> &tilesets,
+                    std::vector<TMXParser::Layer> &layers)
+      : mapInfo(mapInfo), tilesets(tilesets), layers(layers) {}
 
-TMXParser::~TMXParser() = default;
+  void onMap(const TMXParser::MapInfo &info) override { mapInfo = info; }
 
-void TMXParser::loadFile() {
-  XMLError error = doc->LoadFile(tmxFilePath.c_str());
-  if (error != XML_SUCCESS) {
-    throw std::runtime_error(
-        "Failed to load TMX file: " + tmxFilePath +
-        " (Error: " + std::to_string(static_cast<int>(error)) + ")");
+  void onTileset(const TMXParser::TilesetInfo &info) override {
+    tilesets.push_back(info);
   }
 
-  mapElement = doc->RootElement();
-  if (!mapElement || std::string(mapElement->Name()) != "map") {
-    throw std::runtime_error(
-        "Invalid TMX file: missing or invalid map element");
+  std::vector<int> *onLayerBegin(const TMXParser::Layer &layer) override {
+    layers.push_back(layer);
+    return &layers.back().data;
   }
-}
 
-TMXParser::MapInfo TMXParser::getMapInfo() const {
-  if (!mapElement) {
-    throw std::runtime_error("TMX file not loaded. Call loadFile() first.");
+  // Infinite maps: index chunks only, their data is streamed in later
+  void onChunkEnd(const TMXParser::Layer & /*layer*/,
+                  const TMXParser::Chunk &chunk) override {
+    layers.back().chunks.push_back(chunk);
   }
 
-  MapInfo info;
-  info.mapWidth = mapElement->IntAttribute("width");
-  info.mapHeight = mapElement->IntAttribute("height");
-  info.tileWidth = mapElement->IntAttribute("tilewidth");
-  info.tileHeight = mapElement->IntAttribute("tileheight");
-
-  const char *orientation = mapElement->Attribute("orientation");
-  info.orientation = orientation ? orientation : "orthogonal";
+private:
+  TMXParser::MapInfo &mapInfo;
+  std::vector<TMXParser::TilesetInfo> &tilesets;
+  std::vector<TMXParser::Layer> &layers;
+};
 
-  const char *renderOrder = mapElement->Attribute("renderorder");
-  info.renderOrder = renderOrder ? renderOrder : "right-down";
+} // namespace
 
-  return info;
-}
-
-std::vector<TMXParser::TilesetInfo> TMXParser::getTilesetInfo() const {
-  if (!mapElement) {
-    throw std::runtime_error("TMX file not loaded. Call loadFile() first.");
-  }
+TMXParser::TMXParser(const std::string &tmxFilePath)
+    : tmxFilePath(tmxFilePath) {}
 
-  std::vector<TilesetInfo> infos;
-  XMLElement *tilesetElem = mapElement->FirstChildElement("tileset");
-
-  while (tilesetElem) {
-    TilesetInfo info{};
-    info.firstGid = tilesetElem->IntAttribute("firstgid");
-    info.tilesWidth = tilesetElem->IntAttribute("tilewidth");
-    info.tilesHeight = tilesetElem->IntAttribute("tileheight");
-    info.tileCount = tilesetElem->IntAttribute("tilecount");
-    info.columns = tilesetElem->IntAttribute("columns");
-
-    // Calculate rows from tilecount and columns
-    if (info.columns > 0) {
-      info.rows = (info.tileCount + info.columns - 1) /
-                  info.columns; // ceiling division
-    } else {
-      info.rows = 0;
-    }
+TMXParser::~TMXParser() = default;
 
-    // Get image information from the image child element
-    XMLElement *imageElem = tilesetElem->FirstChildElement("image");
-    if (imageElem) {
-      info.imageWidth = imageElem->IntAttribute("width");
-      info.imageHeight = imageElem->IntAttribute("height");
-
-      const char *source = imageElem->Attribute("source");
-      info.imagePath = source ? source : "";
-    } else {
-      info.imageWidth = 0;
-      info.imageHeight = 0;
-      info.imagePath = "";
+void TMXParser::loadFile() {
+  loaded = false;
+  mapInfo = MapInfo{};
+  tilesets.clear();
+  layers.clear();
+
+  CollectingHandler handler(mapInfo, tilesets, layers);
+  TMXReader::readFile(tmxFilePath, handler);
+
+  // Image sources are relative to the map file
+  const auto mapDirectory = std::filesystem::path(tmxFilePath).parent_path();
+  for (auto &tileset : tilesets) {
+    if (!tileset.imagePath.empty()) {
+      tileset.imagePath = (mapDirectory / tileset.imagePath)
+                              .lexically_normal()
+                              .generic_string();
     }
-
-    infos.push_back(info);
-    tilesetElem = tilesetElem->NextSiblingElement("tileset");
   }
-
-  return infos;
+  loaded = true;
 }
 
-std::vector<TMXParser::Layer> TMXParser::getLayersInfo() const {
-  if (!mapElement) {
-    throw std::runtime_error("TMX file not loaded. Call loadFile() first.");
-  }
-
-  std::vector<Layer> layers;
-  XMLElement *layerElem = mapElement->FirstChildElement("layer");
-
-  while (layerElem) {
-    Layer layer{};
-    layer.id = layerElem->IntAttribute("id");
-
-    const char *name = layerElem->Attribute("name");
-    layer.name = name ? name : "";
-
-    layer.width = layerElem->IntAttribute("width");
-    layer.height = layerElem->IntAttribute("height");
-    layer.visible = layerElem->BoolAttribute("visible", true);
-    layer.opacity = layerElem->FloatAttribute("opacity", 1.0f);
-
-    // Parse layer data
-    XMLElement *dataElem = layerElem->FirstChildElement("data");
-    if (dataElem) {
-      const char *encoding = dataElem->Attribute("encoding");
-
-      if (encoding && std::string(encoding) == "csv") {
-        // Parse CSV data
-        const char *csvText = dataElem->GetText();
-        if (csvText) {
-          std::string csvData = csvText;
-          std::istringstream ss(csvData);
-          std::string token;
-
-          while (std::getline(ss, token, ',')) {
-            std::string trimmedToken = trim(token);
-            if (!trimmedToken.empty()) {
-              try {
-                int gid = std::stoi(trimmedToken);
-                layer.data.push_back(gid);
-              } catch (const std::exception &) {
-                // Skip invalid tokens
-                layer.data.push_back(0);
-              }
-            }
-          }
-        }
-      } else {
-        // Other encodings (base64, etc.) not implemented
-        throw std::runtime_error("Unsupported data encoding: " +
-                                 std::string(encoding ? encoding : "unknown"));
-      }
-    }
+TMXParser::MapInfo TMXParser::getMapInfo() const {
+  requireLoaded();
+  return mapInfo;
+}
 
-    layers.push_back(layer);
-    layerElem = layerElem->NextSiblingElement("layer");
-  }
+std::vector<TMXParser::TilesetInfo> TMXParser::getTilesetInfo() const {
+  requireLoaded();
+  return tilesets;
+}
 
+const std::vector<TMXParser::Layer> &TMXParser::getLayersInfo() const {
+  requireLoaded();
   return layers;
 }
 
-std::string TMXParser::trim(const std::string &str) const {
-  size_t start = str.find_first_not_of(" \t\r\n");
-  if (start == std::string::npos) {
-    return "";
+void TMXParser::releaseLayerData() {
+  for (auto &layer : layers) {
+    std::vector<int>().swap(layer.data);
   }
+}
 
-  size_t end = str.find_last_not_of(" \t\r\n");
-  return str.substr(start, end - start + 1);
+void TMXParser::requireLoaded() const {
+  if (!loaded) {
+    throw std::runtime_error("TMX file not loaded. Call loadFile() first.");
+  }
 }
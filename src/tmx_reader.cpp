@@ -0,0 +1,685 @@
+#include "../include/tmx_reader.h"
+#include "../include/vfs.h"
+#include <algorithm>
+#include <cctype>
+#include <cstdlib>
+#include <cstring>
+#include <limits>
+#include <memory>
+#include <stdexcept>
+#include <utility>
+
+namespace {
+
+// Bytes pulled from the stream per read; bounds the parser's text memory
+constexpr size_t READ_BLOCK_SIZE = 64 * 1024;
+
+/**
+ * Minimal XML pull parser over a buffered SDL_RWops stream.
+ *
+ * Element names and attributes are materialized (they are tiny); text
+ * content is never buffered - callers either skip it or decode it in place.
+ */
+class XmlPullParser {
+public:
+  enum class Token { StartElement, EndElement, Text, EndOfDocument };
+
+  /**
+   * @param startOffset Stream position the source is at (for offsets and
+   *                    error messages)
+   */
+  XmlPullParser(SDL_RWops *source, const std::string &sourceName,
+                size_t startOffset = 0)
+      : source(source), sourceName(sourceName), buffer(READ_BLOCK_SIZE),
+        consumed(startOffset) {}
+
+  /**
+   * Advance to the next token. On Text the text is left unconsumed; call
+   * skipText() or readCSV() before calling next() again.
+   */
+  Token next() {
+    if (pendingEnd) {
+      // Self-closing element: report its end without reading anything
+      pendingEnd = false;
+      return Token::EndElement;
+    }
+
+    while (true) {
+      int c = peek();
+      if (c == EOF) {
+        return Token::EndOfDocument;
+      }
+      if (c != '<') {
+        return Token::Text;
+      }
+      get();
+
+      c = peek();
+      if (c == '?') {
+        skipUntil("?>"); // XML declaration / processing instruction
+        continue;
+      }
+      if (c == '!') {
+        get();
+        if (consume("--")) {
+          skipUntil("-->");
+        } else if (consume("[CDATA[")) {
+          skipUntil("]]>");
+        } else {
+          skipUntil(">"); // DOCTYPE
+        }
+        continue;
+      }
+
+      if (c == '/') {
+        get();
+        readName(elementName);
+        skipWhitespace();
+        expect('>');
+        return Token::EndElement;
+      }
+
+      readName(elementName);
+      attributes.clear();
+      while (true) {
+        skipWhitespace();
+        c = peek();
+        if (c == '/') {
+          get();
+          expect('>');
+          pendingEnd = true;
+          return Token::StartElement;
+        }
+        if (c == '>') {
+          get();
+          return Token::StartElement;
+        }
+        if (c == EOF) {
+          fail("unterminated tag <" + elementName + ">");
+        }
+
+        std::string key;
+        std::string value;
+        readName(key);
+        skipWhitespace();
+        expect('=');
+        skipWhitespace();
+        readAttributeValue(value);
+        attributes.emplace_back(std::move(key), std::move(value));
+      }
+    }
+  }
+
+  // Stream offset of the next unread byte
+  size_t offset() const { return consumed + pos; }
+
+  // Name of the element reported by the last Start/EndElement token
+  const std::string &name() const { return elementName; }
+
+  const char *attribute(const char *key) const {
+    for (const auto &attr : attributes) {
+      if (attr.first == key) {
+        return attr.second.c_str();
+      }
+    }
+    return nullptr;
+  }
+
+  int intAttribute(const char *key, int defaultValue = 0) const {
+    const char *value = attribute(key);
+    if (!value) {
+      return defaultValue;
+    }
+    char *end = nullptr;
+    long parsed = std::strtol(value, &end, 10);
+    return end == value ? defaultValue : static_cast<int>(parsed);
+  }
+
+  float floatAttribute(const char *key, float defaultValue = 0.0f) const {
+    const char *value = attribute(key);
+    if (!value) {
+      return defaultValue;
+    }
+    char *end = nullptr;
+    float parsed = std::strtof(value, &end);
+    return end == value ? defaultValue : parsed;
+  }
+
+  bool boolAttribute(const char *key, bool defaultValue = false) const {
+    const char *value = attribute(key);
+    if (!value) {
+      return defaultValue;
+    }
+    if (std::strcmp(value, "1") == 0 || std::strcmp(value, "true") == 0) {
+      return true;
+    }
+    if (std::strcmp(value, "0") == 0 || std::strcmp(value, "false") == 0) {
+      return false;
+    }
+    return defaultValue;
+  }
+
+  // Consume text content up to the next tag
+  void skipText() {
+    while (peek() != '<' && peek() != EOF) {
+      get();
+    }
+  }
+
+  /**
+   * Decode comma separated GIDs from the text content up to the next tag.
+   * Tokens are handled like the old DOM parser: surrounding whitespace is
+   * ignored, empty tokens are skipped and unparsable tokens become 0.
+   * @param out Destination buffer, or nullptr to discard the values
+   */
+  void readCSV(std::vector<int> *out) {
+    bool inToken = false; // saw a non-space character in this token
+    bool parsing = false; // still reading the leading number
+    bool negative = false;
+    bool hasDigits = false;
+    long long value = 0;
+
+    auto emit = [&]() {
+      if (inToken && out) {
+        long long gid = negative ? -value : value;
+        // Flipped/rotated GIDs don't fit an int and are not supported
+        bool valid = hasDigits && gid <= std::numeric_limits<int>::max() &&
+                     gid >= std::numeric_limits<int>::min();
+        out->push_back(valid ? static_cast<int>(gid) : 0);
+      }
+      inToken = parsing = negative = hasDigits = false;
+      value = 0;
+    };
+
+    while (true) {
+      int c = peek();
+      if (c == '<' || c == EOF) {
+        break;
+      }
+      get();
+
+      if (c == ',') {
+        emit();
+        continue;
+      }
+      if (std::isspace(c)) {
+        if (hasDigits) {
+          parsing = false; // Number ended; rest of token is ignored
+        }
+        continue;
+      }
+
+      if (!inToken) {
+        inToken = true;
+        parsing = true;
+        if (c == '-' || c == '+') {
+          negative = (c == '-');
+          continue;
+        }
+      }
+
+      if (parsing && std::isdigit(c)) {
+        hasDigits = true;
+        if (value <= std::numeric_limits<int>::max()) {
+          value = value * 10 + (c - '0');
+        }
+      } else {
+        parsing = false;
+      }
+    }
+    emit();
+  }
+
+  // Skip the rest of the element whose StartElement was just returned
+  void skipElement() {
+    int depth = 1;
+    while (depth > 0) {
+      switch (next()) {
+      case Token::StartElement:
+        ++depth;
+        break;
+      case Token::EndElement:
+        --depth;
+        break;
+      case Token::Text:
+        skipText();
+        break;
+      case Token::EndOfDocument:
+        fail("unexpected end of document inside <" + elementName + ">");
+      }
+    }
+  }
+
+  [[noreturn]] void fail(const std::string &message) const {
+    throw std::runtime_error("Failed to load TMX file: " + sourceName + " (" +
+                             message + " at byte " +
+                             std::to_string(offset()) + ")");
+  }
+
+private:
+  SDL_RWops *source;
+  std::string sourceName;
+
+  std::vector<char> buffer;
+  size_t pos = 0;      // Read position in buffer
+  size_t end = 0;      // Valid bytes in buffer
+  size_t consumed = 0; // Stream bytes before buffer[0]
+  bool eof = false;
+
+  std::string elementName;
+  std::vector<std::pair<std::string, std::string>> attributes;
+  bool pendingEnd = false;
+
+  bool fill() {
+    if (eof) {
+      return false;
+    }
+    consumed += end;
+    pos = 0;
+    end = SDL_RWread(source, buffer.data(), 1, buffer.size());
+    if (end == 0) {
+      eof = true;
+      return false;
+    }
+    return true;
+  }
+
+  int peek() {
+    if (pos >= end && !fill()) {
+      return EOF;
+    }
+    return static_cast<unsigned char>(buffer[pos]);
+  }
+
+  int get() {
+    int c = peek();
+    if (c != EOF) {
+      ++pos;
+    }
+    return c;
+  }
+
+  void expect(char expected) {
+    if (get() != expected) {
+      fail(std::string("expected '") + expected + "'");
+    }
+  }
+
+  // Consume literal if it comes next. Only used for short markers right
+  // after '<!', where a partial match means the markup is malformed anyway.
+  bool consume(const char *literal) {
+    if (peek() != literal[0]) {
+      return false;
+    }
+    for (const char *p = literal; *p; ++p) {
+      if (get() != *p) {
+        fail(std::string("malformed markup, expected '") + literal + "'");
+      }
+    }
+    return true;
+  }
+
+  // Consume everything up to and including terminator
+  void skipUntil(const char *terminator) {
+    const size_t length = std::strlen(terminator);
+    size_t matched = 0;
+    while (matched < length) {
+      int c = get();
+      if (c == EOF) {
+        fail(std::string("missing '") + terminator + "'");
+      }
+      if (c == terminator[matched]) {
+        ++matched;
+      } else {
+        matched = (c == terminator[0]) ? 1 : 0;
+      }
+    }
+  }
+
+  void skipWhitespace() {
+    while (std::isspace(peek())) {
+      get();
+    }
+  }
+
+  void readName(std::string &out) {
+    out.clear();
+    while (true) {
+      int c = peek();
+      if (c == EOF || std::isspace(c) || c == '>' || c == '/' || c == '=') {
+        break;
+      }
+      out.push_back(static_cast<char>(get()));
+    }
+    if (out.empty()) {
+      fail("expected a name");
+    }
+  }
+
+  void readAttributeValue(std::string &out) {
+    int quote = get();
+    if (quote != '"' && quote != '\'') {
+      fail("expected quoted attribute value");
+    }
+    out.clear();
+    while (true) {
+      int c = get();
+      if (c == EOF) {
+        fail("unterminated attribute value");
+      }
+      if (c == quote) {
+        break;
+      }
+      if (c == '&') {
+        appendEntity(out);
+      } else {
+        out.push_back(static_cast<char>(c));
+      }
+    }
+  }
+
+  // Decode an entity reference (the '&' is already consumed)
+  void appendEntity(std::string &out) {
+    std::string entity;
+    while (true) {
+      int c = get();
+      if (c == EOF || entity.size() > 8) {
+        fail("malformed entity");
+      }
+      if (c == ';') {
+        break;
+      }
+      entity.push_back(static_cast<char>(c));
+    }
+
+    if (entity == "amp") {
+      out.push_back('&');
+    } else if (entity == "lt") {
+      out.push_back('<');
+    } else if (entity == "gt") {
+      out.push_back('>');
+    } else if (entity == "quot") {
+      out.push_back('"');
+    } else if (entity == "apos") {
+      out.push_back('\'');
+    } else if (entity.size() > 1 && entity[0] == '#') {
+      bool hex = entity[1] == 'x' || entity[1] == 'X';
+      unsigned long code =
+          std::strtoul(entity.c_str() + (hex ? 2 : 1), nullptr, hex ? 16 : 10);
+      // Attribute values we care about are ASCII; keep others as '?'
+      out.push_back(code < 0x80 ? static_cast<char>(code) : '?');
+    } else {
+      fail("unknown entity &" + entity + ";");
+    }
+  }
+};
+
+using Token = XmlPullParser::Token;
+
+void readAnimation(XmlPullParser &xml,
+                   std::vector<TMXParser::AnimationFrame> &frames) {
+  while (true) {
+    Token token = xml.next();
+    if (token == Token::Text) {
+      xml.skipText();
+    } else if (token == Token::StartElement) {
+      if (xml.name() == "frame") {
+        frames.push_back({xml.intAttribute("tileid"),
+                          xml.intAttribute("duration")});
+      }
+      xml.skipElement();
+    } else if (token == Token::EndElement) {
+      break;
+    } else {
+      xml.fail("unexpected end of document inside <animation>");
+    }
+  }
+}
+
+// A tileset's <tile>; only its <animation> is used
+void readTile(XmlPullParser &xml, TMXParser::TilesetInfo &info) {
+  TMXParser::TileAnimation animation;
+  animation.tileId = xml.intAttribute("id");
+
+  while (true) {
+    Token token = xml.next();
+    if (token == Token::Text) {
+      xml.skipText();
+    } else if (token == Token::StartElement) {
+      if (xml.name() == "animation") {
+        readAnimation(xml, animation.frames);
+      } else {
+        xml.skipElement();
+      }
+    } else if (token == Token::EndElement) {
+      break;
+    } else {
+      xml.fail("unexpected end of document inside <tile>");
+    }
+  }
+
+  if (!animation.frames.empty()) {
+    info.animations.push_back(std::move(animation));
+  }
+}
+
+void readTileset(XmlPullParser &xml, TMXReader::Handler &handler) {
+  TMXParser::TilesetInfo info{};
+  info.firstGid = xml.intAttribute("firstgid");
+  info.tilesWidth = xml.intAttribute("tilewidth");
+  info.tilesHeight = xml.intAttribute("tileheight");
+  info.tileCount = xml.intAttribute("tilecount");
+  info.columns = xml.intAttribute("columns");
+
+  // Calculate rows from tilecount and columns
+  if (info.columns > 0) {
+    info.rows =
+        (info.tileCount + info.columns - 1) / info.columns; // ceiling division
+  } else {
+    info.rows = 0;
+  }
+
+  while (true) {
+    Token token = xml.next();
+    if (token == Token::Text) {
+      xml.skipText();
+    } else if (token == Token::StartElement) {
+      if (xml.name() == "tile") {
+        readTile(xml, info);
+        continue;
+      }
+      if (xml.name() == "image") {
+        info.imageWidth = xml.intAttribute("width");
+        info.imageHeight = xml.intAttribute("height");
+        const char *source = xml.attribute("source");
+        info.imagePath = source ? source : "";
+      }
+      xml.skipElement();
+    } else if (token == Token::EndElement) {
+      break;
+    } else {
+      xml.fail("unexpected end of document inside <tileset>");
+    }
+  }
+
+  handler.onTileset(info);
+}
+
+void readChunk(XmlPullParser &xml, TMXReader::Handler &handler,
+               const TMXParser::Layer &layer) {
+  TMXParser::Chunk chunk{};
+  chunk.x = xml.intAttribute("x");
+  chunk.y = xml.intAttribute("y");
+  chunk.width = xml.intAttribute("width");
+  chunk.height = xml.intAttribute("height");
+  chunk.dataOffset = xml.offset();
+
+  std::vector<int> *destination = handler.onChunkBegin(layer, chunk);
+
+  // Decode the chunk text even when only indexing so tileCount is known
+  std::vector<int> scratch;
+  std::vector<int> *target = destination ? destination : &scratch;
+  size_t before = target->size();
+
+  while (true) {
+    Token token = xml.next();
+    if (token == Token::Text) {
+      xml.readCSV(target);
+    } else if (token == Token::StartElement) {
+      xml.skipElement();
+    } else if (token == Token::EndElement) {
+      break;
+    } else {
+      xml.fail("unexpected end of document inside <chunk>");
+    }
+  }
+
+  chunk.tileCount = static_cast<int>(
+      std::count_if(target->begin() + static_cast<std::ptrdiff_t>(before),
+                    target->end(), [](int gid) { return gid != 0; }));
+  handler.onChunkEnd(layer, chunk);
+}
+
+void readLayer(XmlPullParser &xml, TMXReader::Handler &handler) {
+  TMXParser::Layer layer{};
+  layer.id = xml.intAttribute("id");
+  const char *name = xml.attribute("name");
+  layer.name = name ? name : "";
+  layer.width = xml.intAttribute("width");
+  layer.height = xml.intAttribute("height");
+  layer.visible = xml.boolAttribute("visible", true);
+  layer.opacity = xml.floatAttribute("opacity", 1.0f);
+
+  std::vector<int> *destination = handler.onLayerBegin(layer);
+
+  while (true) {
+    Token token = xml.next();
+    if (token == Token::Text) {
+      xml.skipText();
+      continue;
+    }
+    if (token == Token::EndElement) {
+      break;
+    }
+    if (token == Token::EndOfDocument) {
+      xml.fail("unexpected end of document inside <layer>");
+    }
+
+    if (xml.name() != "data") {
+      xml.skipElement();
+      continue;
+    }
+
+    const char *encoding = xml.attribute("encoding");
+    if (!encoding || std::string(encoding) != "csv") {
+      // Other encodings (base64, etc.) not implemented
+      throw std::runtime_error("Unsupported data encoding: " +
+                               std::string(encoding ? encoding : "unknown"));
+    }
+
+    if (destination) {
+      destination->reserve(static_cast<size_t>(std::max(0, layer.width)) *
+                           static_cast<size_t>(std::max(0, layer.height)));
+    }
+
+    // Decode data text directly into the handler's buffer
+    while (true) {
+      Token dataToken = xml.next();
+      if (dataToken == Token::Text) {
+        xml.readCSV(destination);
+      } else if (dataToken == Token::StartElement) {
+        if (xml.name() == "chunk") {
+          readChunk(xml, handler, layer);
+        } else {
+          xml.skipElement();
+        }
+      } else if (dataToken == Token::EndElement) {
+        break;
+      } else {
+        xml.fail("unexpected end of document inside <data>");
+      }
+    }
+  }
+
+  handler.onLayerEnd(layer);
+}
+
+} // namespace
+
+void TMXReader::read(SDL_RWops *source, Handler &handler,
+                     const std::string &sourceName) {
+  if (!source) {
+    throw std::runtime_error("Failed to load TMX file: " + sourceName +
+                             " (null stream)");
+  }
+
+  XmlPullParser xml(source, sourceName);
+
+  // Find the root element
+  Token token;
+  while ((token = xml.next()) == Token::Text) {
+    xml.skipText();
+  }
+  if (token != Token::StartElement || xml.name() != "map") {
+    throw std::runtime_error(
+        "Invalid TMX file: missing or invalid map element");
+  }
+
+  TMXParser::MapInfo info{};
+  info.mapWidth = xml.intAttribute("width");
+  info.mapHeight = xml.intAttribute("height");
+  info.tileWidth = xml.intAttribute("tilewidth");
+  info.tileHeight = xml.intAttribute("tileheight");
+  const char *orientation = xml.attribute("orientation");
+  info.orientation = orientation ? orientation : "orthogonal";
+  const char *renderOrder = xml.attribute("renderorder");
+  info.renderOrder = renderOrder ? renderOrder : "right-down";
+  info.infinite = xml.boolAttribute("infinite", false);
+  handler.onMap(info);
+
+  // Top-level children of <map>
+  while (true) {
+    token = xml.next();
+    if (token == Token::Text) {
+      xml.skipText();
+    } else if (token == Token::StartElement) {
+      if (xml.name() == "tileset") {
+        readTileset(xml, handler);
+      } else if (xml.name() == "layer") {
+        readLayer(xml, handler);
+      } else {
+        xml.skipElement();
+      }
+    } else if (token == Token::EndElement) {
+      break; // </map>
+    } else {
+      xml.fail("unexpected end of document inside <map>");
+    }
+  }
+}
+
+void TMXReader::readChunkData(SDL_RWops *source, size_t dataOffset,
+                              std::vector<int> &out,
+                              const std::string &sourceName) {
+  if (!source || SDL_RWseek(source, static_cast<Sint64>(dataOffset),
+                            RW_SEEK_SET) < 0) {
+    throw std::runtime_error("Failed to seek TMX file: " + sourceName +
+                             " to byte " + std::to_string(dataOffset));
+  }
+
+  XmlPullParser xml(source, sourceName, dataOffset);
+  xml.readCSV(&out);
+}
+
+void TMXReader::readFile(const std::string &filePath, Handler &handler) {
+  std::unique_ptr<SDL_RWops, int (*)(SDL_RWops *)> file(
+      Vfs::resources().open(filePath), [](SDL_RWops *rw) {
+        return rw ? SDL_RWclose(rw) : 0;
+      });
+  if (!file) {
+    throw std::runtime_error("Failed to load TMX file: " + filePath + " - " +
+                             SDL_GetError());
+  }
+
+  read(file.get(), handler, filePath);
+}
@@ -0,0 +1,256 @@
+#include "../include/vfs.h"
+#include "../include/config.h"
+#include "../include/pack_format.h"
+#include <algorithm>
+#include <climits>
+#include <cstring>
+#include <filesystem>
+#include <iostream>
+#include <vector>
+
+#ifdef _WIN32
+#define WIN32_LEAN_AND_MEAN
+#include <windows.h>
+#else
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#endif
+
+namespace fs = std::filesystem;
+
+Vfs::~Vfs() { unmount(); }
+
+Vfs &Vfs::resources() {
+  static Vfs vfs;
+  return vfs;
+}
+
+bool Vfs::mountPack(const std::string &packPath) {
+  entries.clear();
+  unmapFile();
+  if (!mapFile(packPath))
+    return false;
+
+  auto invalid = [&](const char *reason) {
+    std::cerr << "Invalid resource pack " << packPath << ": " << reason
+              << std::endl;
+    entries.clear();
+    unmapFile();
+    return false;
+  };
+
+  if (mappingSize < PackFormat::HEADER_SIZE ||
+      std::memcmp(mapping, PackFormat::MAGIC, sizeof(PackFormat::MAGIC)) != 0)
+    return invalid("bad magic");
+  if (PackFormat::readU32(mapping + 4) != PackFormat::VERSION)
+    return invalid("unsupported version");
+
+  const std::uint64_t entryCount = PackFormat::readU32(mapping + 8);
+  if (PackFormat::HEADER_SIZE + entryCount * PackFormat::ENTRY_SIZE >
+      mappingSize)
+    return invalid("truncated entry table");
+
+  entries.reserve(static_cast<size_t>(entryCount));
+  for (std::uint64_t i = 0; i < entryCount; ++i) {
+    const PackFormat::Entry entry = PackFormat::readEntry(
+        mapping + PackFormat::HEADER_SIZE + i * PackFormat::ENTRY_SIZE);
+    if (static_cast<std::uint64_t>(entry.nameOffset) + entry.nameLength >
+            mappingSize ||
+        entry.offset > mappingSize || entry.size > mappingSize - entry.offset)
+      return invalid("entry out of bounds");
+
+    std::string name(reinterpret_cast<const char *>(mapping) +
+                         entry.nameOffset,
+                     entry.nameLength);
+    entries[normalize(name)] =
+        Region{mapping + entry.offset, static_cast<size_t>(entry.size)};
+  }
+
+  std::cout << "Mounted resource pack " << packPath << " (" << entries.size()
+            << " files)" << std::endl;
+  return true;
+}
+
+void Vfs::mountDirectory(const std::string &directoryPath) {
+  directory = directoryPath;
+  std::cout << "Mounted resource directory " << directoryPath << std::endl;
+}
+
+bool Vfs::mountDefault() {
+  // Next to the executable first, so the working directory doesn't matter
+  std::vector<std::string> roots;
+  if (char *basePath = SDL_GetBasePath()) {
+    roots.emplace_back(basePath);
+    SDL_free(basePath);
+  }
+  roots.emplace_back("./");
+  roots.emplace_back("../");
+
+  std::error_code error;
+  for (const auto &root : roots) {
+    if (!mapping && fs::is_regular_file(root + RESOURCE_PACK_NAME, error))
+      mountPack(root + RESOURCE_PACK_NAME);
+    if (directory.empty() && fs::is_directory(root + RESOURCE_DIR_NAME, error))
+      mountDirectory(root + RESOURCE_DIR_NAME);
+  }
+
+  if (!mapping && directory.empty()) {
+    std::cerr << "No resources found (" << RESOURCE_PACK_NAME << " or "
+              << RESOURCE_DIR_NAME << "/)" << std::endl;
+    return false;
+  }
+  return true;
+}
+
+void Vfs::unmount() {
+  entries.clear();
+  unmapFile();
+  directory.clear();
+}
+
+bool Vfs::exists(const std::string &path) const {
+  size_t size = 0;
+  if (find(path, size))
+    return true;
+
+  const std::string name = normalize(path);
+  std::error_code error;
+  if (fs::path(name).is_absolute())
+    return fs::is_regular_file(name, error);
+  return !directory.empty() &&
+         fs::is_regular_file(directory + "/" + name, error);
+}
+
+SDL_RWops *Vfs::open(const std::string &path) const {
+  size_t size = 0;
+  if (const void *data = find(path, size)) {
+    if (size > static_cast<size_t>(INT_MAX)) {
+      SDL_SetError("Resource too large: %s", path.c_str());
+      return nullptr;
+    }
+    return SDL_RWFromConstMem(data, static_cast<int>(size));
+  }
+
+  const std::string name = normalize(path);
+  if (fs::path(name).is_absolute())
+    return SDL_RWFromFile(name.c_str(), "rb");
+  if (directory.empty()) {
+    SDL_SetError("Resource not found: %s", name.c_str());
+    return nullptr;
+  }
+  return SDL_RWFromFile((directory + "/" + name).c_str(), "rb");
+}
+
+const void *Vfs::find(const std::string &path, size_t &size) const {
+  if (entries.empty())
+    return nullptr;
+  auto it = entries.find(normalize(path));
+  if (it == entries.end())
+    return nullptr;
+  size = it->second.size;
+  return it->second.data;
+}
+
+std::string Vfs::normalize(const std::string &path) {
+  std::string generic = path;
+  std::replace(generic.begin(), generic.end(), '\\', '/');
+  if (fs::path(generic).is_absolute())
+    return fs::path(generic).lexically_normal().generic_string();
+
+  // Resolve against the root directory's name so paths that step out and
+  // back in ("../resources/x.png") collapse to the same name
+  const fs::path resolved =
+      (fs::path(RESOURCE_DIR_NAME) / generic).lexically_normal();
+  auto part = resolved.begin();
+  if (part == resolved.end() || *part != RESOURCE_DIR_NAME)
+    return (fs::path("..") / resolved).generic_string(); // Outside the root
+
+  fs::path relative;
+  for (++part; part != resolved.end(); ++part) {
+    relative /= *part;
+  }
+  return relative.generic_string();
+}
+
+#ifdef _WIN32
+
+bool Vfs::mapFile(const std::string &packPath) {
+  HANDLE file = CreateFileA(packPath.c_str(), GENERIC_READ, FILE_SHARE_READ,
+                            nullptr, OPEN_EXISTING, FILE_ATTRIBUTE_NORMAL,
+                            nullptr);
+  if (file == INVALID_HANDLE_VALUE) {
+    std::cerr << "Cannot open resource pack: " << packPath << std::endl;
+    return false;
+  }
+
+  LARGE_INTEGER size;
+  HANDLE view = nullptr;
+  if (GetFileSizeEx(file, &size) && size.QuadPart > 0)
+    view = CreateFileMappingA(file, nullptr, PAGE_READONLY, 0, 0, nullptr);
+  const void *data =
+      view ? MapViewOfFile(view, FILE_MAP_READ, 0, 0, 0) : nullptr;
+  if (!data) {
+    std::cerr << "Cannot map resource pack: " << packPath << std::endl;
+    if (view)
+      CloseHandle(view);
+    CloseHandle(file);
+    return false;
+  }
+
+  fileHandle = file;
+  mappingHandle = view;
+  mapping = static_cast<const unsigned char *>(data);
+  mappingSize = static_cast<size_t>(size.QuadPart);
+  return true;
+}
+
+void Vfs::unmapFile() {
+  if (mapping)
+    UnmapViewOfFile(mapping);
+  if (mappingHandle)
+    CloseHandle(mappingHandle);
+  if (fileHandle)
+    CloseHandle(fileHandle);
+  mapping = nullptr;
+  mappingSize = 0;
+  mappingHandle = nullptr;
+  fileHandle = nullptr;
+}
+
+#else
+
+bool Vfs::mapFile(const std::string &packPath) {
+  int fd = ::open(packPath.c_str(), O_RDONLY);
+  if (fd < 0) {
+    std::cerr << "Cannot open resource pack: " << packPath << std::endl;
+    return false;
+  }
+
+  // The mapping keeps the file alive; the descriptor isn't needed after
+  struct stat info;
+  void *data = MAP_FAILED;
+  if (fstat(fd, &info) == 0 && info.st_size > 0) {
+    data = mmap(nullptr, static_cast<size_t>(info.st_size), PROT_READ,
+                MAP_PRIVATE, fd, 0);
+  }
+  ::close(fd);
+  if (data == MAP_FAILED) {
+    std::cerr << "Cannot map resource pack: " << packPath << std::endl;
+    return false;
+  }
+
+  mapping = static_cast<const unsigned char *>(data);
+  mappingSize = static_cast<size_t>(info.st_size);
+  return true;
+}
+
+void Vfs::unmapFile() {
+  if (mapping)
+    munmap(const_cast<unsigned char *>(mapping), mappingSize);
+  mapping = nullptr;
+  mappingSize = 0;
+}
+
+#endif
@@ -0,0 +1,84 @@
+#include "../include/voice_manager.h"
+#include <algorithm>
+
+VoiceManager::VoiceManager(int voiceCount)
+    : voices(static_cast<size_t>(std::max(1, voiceCount))) {}
+
+void VoiceManager::setParams(SoundHandle sound, const SoundParams &params) {
+  SoundParams clamped = params;
+  clamped.maxInstances = std::max(1, clamped.maxInstances);
+  this->params[sound] = clamped;
+}
+
+VoiceManager::SoundParams VoiceManager::getParams(SoundHandle sound) const {
+  auto it = params.find(sound);
+  return it == params.end() ? SoundParams{} : it->second;
+}
+
+int VoiceManager::allocate(SoundHandle sound) {
+  const SoundParams soundParams = getParams(sound);
+
+  // At the instance cap: restart this sound's oldest instance
+  int instances = 0;
+  int oldestOwn = -1;
+  int freeVoice = -1;
+  for (int i = 0; i < getVoiceCount(); ++i) {
+    const Voice &voice = voices[i];
+    if (!voice.active) {
+      if (freeVoice < 0)
+        freeVoice = i;
+      continue;
+    }
+    if (voice.sound == sound) {
+      ++instances;
+      if (oldestOwn < 0 || voice.startOrder < voices[oldestOwn].startOrder)
+        oldestOwn = i;
+    }
+  }
+  if (instances >= soundParams.maxInstances)
+    return claim(oldestOwn, sound, soundParams.priority);
+
+  if (freeVoice >= 0)
+    return claim(freeVoice, sound, soundParams.priority);
+
+  // All voices busy: steal the oldest of the lowest priority, as long as it
+  // doesn't outrank the new sound
+  int victim = -1;
+  for (int i = 0; i < getVoiceCount(); ++i) {
+    const Voice &voice = voices[i];
+    if (voice.priority > soundParams.priority)
+      continue;
+    if (victim < 0 || voice.priority < voices[victim].priority ||
+        (voice.priority == voices[victim].priority &&
+         voice.startOrder < voices[victim].startOrder)) {
+      victim = i;
+    }
+  }
+  if (victim < 0)
+    return -1;
+  return claim(victim, sound, soundParams.priority);
+}
+
+void VoiceManager::release(int voice) {
+  if (voice >= 0 && voice < getVoiceCount())
+    voices[voice].active = false;
+}
+
+bool VoiceManager::isActive(int voice) const {
+  return voice >= 0 && voice < getVoiceCount() && voices[voice].active;
+}
+
+int VoiceManager::getActiveCount() const {
+  return static_cast<int>(
+      std::count_if(voices.begin(), voices.end(),
+                    [](const Voice &voice) { return voice.active; }));
+}
+
+int VoiceManager::claim(int voice, SoundHandle sound, int priority) {
+  Voice &slot = voices[voice];
+  slot.active = true;
+  slot.sound = sound;
+  slot.priority = priority;
+  slot.startOrder = nextStartOrder++;
+  return voice;
+}
@@ -0,0 +1,124 @@
+/**
+ * pack_resources - Build step that packs a resource directory into one file
+ *
+ * Usage: pack_resources <resource dir> <output.pak>
+ *
+ * Every regular file under the directory is stored uncompressed (the game
+ * maps the pack and reads assets in place) under its path relative to the
+ * directory. See include/pack_format.h for the layout.
+ */
+#include "../include/pack_format.h"
+#include <algorithm>
+#include <filesystem>
+#include <fstream>
+#include <iostream>
+#include <string>
+#include <vector>
+
+namespace fs = std::filesystem;
+
+namespace {
+
+struct PackedFile {
+  fs::path source;
+  std::string name;
+  PackFormat::Entry entry;
+};
+
+std::uint64_t alignUp(std::uint64_t value, std::uint64_t alignment) {
+  return (value + alignment - 1) / alignment * alignment;
+}
+
+} // namespace
+
+int main(int argc, char *argv[]) {
+  if (argc != 3) {
+    std::cerr << "Usage: " << argv[0] << " <resource dir> <output.pak>"
+              << std::endl;
+    return 1;
+  }
+  const fs::path root = argv[1];
+  const fs::path output = argv[2];
+
+  std::vector<PackedFile> files;
+  try {
+    for (const auto &item : fs::recursive_directory_iterator(root)) {
+      if (!item.is_regular_file())
+        continue;
+      PackedFile file;
+      file.source = item.path();
+      file.name = item.path().lexically_relative(root).generic_string();
+      file.entry = PackFormat::Entry{0, item.file_size(), 0, 0};
+      files.push_back(std::move(file));
+    }
+  } catch (const fs::filesystem_error &e) {
+    std::cerr << "Failed to scan " << root << ": " << e.what() << std::endl;
+    return 1;
+  }
+
+  // Sorted names make the pack reproducible
+  std::sort(files.begin(), files.end(),
+            [](const PackedFile &a, const PackedFile &b) {
+              return a.name < b.name;
+            });
+
+  // Lay out names after the entry table, then the aligned file data
+  std::uint64_t cursor =
+      PackFormat::HEADER_SIZE + PackFormat::ENTRY_SIZE * files.size();
+  for (auto &file : files) {
+    file.entry.nameOffset = static_cast<std::uint32_t>(cursor);
+    file.entry.nameLength = static_cast<std::uint32_t>(file.name.size());
+    cursor += file.name.size();
+  }
+  for (auto &file : files) {
+    cursor = alignUp(cursor, PackFormat::DATA_ALIGNMENT);
+    file.entry.offset = cursor;
+    cursor += file.entry.size;
+  }
+
+  std::ofstream out(output, std::ios::binary | std::ios::trunc);
+  if (!out) {
+    std::cerr << "Cannot write " << output << std::endl;
+    return 1;
+  }
+
+  unsigned char header[PackFormat::HEADER_SIZE] = {};
+  std::copy(std::begin(PackFormat::MAGIC), std::end(PackFormat::MAGIC),
+            header);
+  PackFormat::writeU32(header + 4, PackFormat::VERSION);
+  PackFormat::writeU32(header + 8, static_cast<std::uint32_t>(files.size()));
+  out.write(reinterpret_cast<const char *>(header), sizeof(header));
+
+  for (const auto &file : files) {
+    unsigned char entry[PackFormat::ENTRY_SIZE];
+    PackFormat::writeEntry(entry, file.entry);
+    out.write(reinterpret_cast<const char *>(entry), sizeof(entry));
+  }
+  for (const auto &file : files) {
+    out.write(file.name.data(), static_cast<std::streamsize>(file.name.size()));
+  }
+
+  std::vector<char> buffer;
+  for (const auto &file : files) {
+    // Zero padding up to the aligned start
+    const auto position = static_cast<std::uint64_t>(out.tellp());
+    out.write(std::string(file.entry.offset - position, '\0').data(),
+              static_cast<std::streamsize>(file.entry.offset - position));
+
+    std::ifstream in(file.source, std::ios::binary);
+    buffer.resize(static_cast<size_t>(file.entry.size));
+    if (!in.read(buffer.data(), static_cast<std::streamsize>(buffer.size()))) {
+      std::cerr << "Failed to read " << file.source << std::endl;
+      return 1;
+    }
+    out.write(buffer.data(), static_cast<std::streamsize>(buffer.size()));
+  }
+
+  if (!out) {
+    std::cerr << "Failed to write " << output << std::endl;
+    return 1;
+  }
+  std::cout << "Packed " << files.size() << " files (" << cursor
+            << " bytes) into " << output.string() << std::endl;
+  return 0;
+}